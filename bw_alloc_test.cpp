@@ -0,0 +1,125 @@
+#include "mesh.h"
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <random>
+#include <vector>
+
+// Number of heap allocations made so far by the whole program
+static std::atomic<long long> lAllocations{0};
+
+void* operator new(std::size_t uSize)
+{
+    lAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(uSize ? uSize : 1))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+static const int BUILD_POINTS = 20000;  // Points triangulated by the build that warms up the scratch buffers
+static const int WARMUP_INSERTIONS = 100;  // Single-point insertions made before counting
+static const int COUNTED_INSERTIONS = 5000;  // Single-point insertions made while counting
+
+// Locates and inserts the points one at a time and returns the number of points inserted
+static int insertOneByOne(Mesh& mesh, const std::vector<Point>& vecPt)
+{
+    int iInserted = 0;
+    for (const Point& pt : vecPt)
+    {
+        const int iTriIndex = mesh.findContainingTriangle(pt);
+        if (iTriIndex == -1)
+        {
+            continue;
+        }
+        mesh.insertPoint(iTriIndex, mesh.addPoint(pt));
+        ++iInserted;
+    }
+    return iInserted;
+}
+
+// Builds a mesh with the given settings, reserves room for the later points, warms up with a few insertions and
+// returns the number of allocations made by the counted single-point insertions (-1 if a point was not inserted)
+static long long countInsertionAllocations(InsertionEngine eEngine, bool bSort, bool bGrid)
+{
+    std::mt19937 gen(2024);
+    std::uniform_real_distribution<float> dis(0.0f, 1000.0f);
+    std::vector<Point> vecPt;
+    for (int i = 0; i < BUILD_POINTS; ++i)
+    {
+        vecPt.emplace_back(dis(gen), dis(gen));
+    }
+
+    // The later points stay inside the box of the build, so they fall in the super triangle
+    std::vector<Point> vecWarmup, vecCounted;
+    for (int i = 0; i < WARMUP_INSERTIONS; ++i)
+    {
+        vecWarmup.emplace_back(dis(gen), dis(gen));
+    }
+    for (int i = 0; i < COUNTED_INSERTIONS; ++i)
+    {
+        vecCounted.emplace_back(dis(gen), dis(gen));
+    }
+
+    Mesh mesh(vecPt);
+    mesh.setInsertionEngine(eEngine);
+    mesh.setSpatialSort(bSort);
+    mesh.setTriVector({ mesh.superTriangle() });
+    mesh.buildMesh();
+    if (bGrid)
+    {
+        mesh.enableGridIndex();
+    }
+    mesh.reserve(BUILD_POINTS + WARMUP_INSERTIONS + COUNTED_INSERTIONS);
+
+    if (insertOneByOne(mesh, vecWarmup) != WARMUP_INSERTIONS)
+    {
+        return -1;
+    }
+
+    const long long lBefore = lAllocations.load();
+    const int iInserted = insertOneByOne(mesh, vecCounted);
+    const long long lCount = lAllocations.load() - lBefore;
+
+    return iInserted == COUNTED_INSERTIONS ? lCount : -1;
+}
+
+// Checks that a single-point insertion into a built and reserved mesh does not allocate, with both insertion
+// engines, with and without the spatially sorted build and with and without the bucket grid
+int main()
+{
+    int iFailures = 0;
+    for (InsertionEngine eEngine : { InsertionEngine::SplitAndFlip, InsertionEngine::BowyerWatson })
+    {
+        for (bool bSort : { false, true })
+        {
+            for (bool bGrid : { false, true })
+            {
+                const long long lCount = countInsertionAllocations(eEngine, bSort, bGrid);
+                std::cout << (eEngine == InsertionEngine::BowyerWatson ? "BowyerWatson" : "SplitAndFlip")
+                          << (bSort ? ", sorted" : ", unsorted") << (bGrid ? ", grid" : ", no grid")
+                          << ": " << lCount << " allocations for " << COUNTED_INSERTIONS << " insertions" << std::endl;
+
+                if (lCount != 0)
+                {
+                    std::cerr << (lCount < 0 ? "A point was not inserted." : "The insertion allocates.") << std::endl;
+                    ++iFailures;
+                }
+            }
+        }
+    }
+
+    return iFailures == 0 ? 0 : 1;
+}
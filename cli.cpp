@@ -0,0 +1,194 @@
+#include "mesh.h"
+#include "pointloader.h"
+#include "meshio.h"
+#include "streamingmesh.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Prints the command line options
+static void printUsage()
+{
+    std::cerr << "Usage: delaunay_cli <points> [options]\n"
+                 "  <points>               raw float32 x/y file (.bin) or CSV / XYZ text\n"
+                 "  -o, --output <path>    write the mesh: .dmesh (binary mesh), .obj, .ply, or .node (with .ele and .neigh)\n"
+                 "  --engine <name>        insertion engine: flip (default), bw (Bowyer-Watson) or dc (parallel divide-and-conquer)\n"
+                 "  --sort                 insert the points in BRIO / Hilbert order\n"
+                 "  --no-remove            keep the super triangle\n"
+                 "  --no-refine            skip the refinement\n"
+                 "  --parallel-refine      refine conflict-free batches of triangles in parallel\n"
+                 "  --threads <n>          number of threads of the parallel engines (default: every hardware thread)\n"
+                 "  --point-limit <n>      maximum number of points added by the refinement\n"
+                 "  --stream <cells>       triangulate an \"x y\" text file out of core with cells x cells finalization cells,\n"
+                 "                         writing OBJ to the output (no removal or refinement)\n"
+                 "  -q, --quiet            do not print the summary" << std::endl;
+}
+
+// Checks whether a string ends with a suffix
+static bool endsWith(const std::string& sText, const char* psSuffix)
+{
+    const size_t uLength = std::strlen(psSuffix);
+    return sText.size() >= uLength && sText.compare(sText.size() - uLength, uLength, psSuffix) == 0;
+}
+
+// Returns the seconds elapsed since a time point
+static double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Batch triangulation without Qt: reads points, builds the mesh, removes the helper triangles, refines and writes the result.
+int main(int argc, char* argv[])
+{
+    std::string sInputPath, sOutputPath, sEngine = "flip";
+    bool bSort = false, bRemove = true, bRefine = true, bParallelRefine = false, bQuiet = false;
+    int iThreads = 0, iPointLimit = 0, iStreamCells = 0;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string sArg = argv[i];
+        const bool bHasValue = i + 1 < argc;
+
+        if ((sArg == "-o" || sArg == "--output") && bHasValue) sOutputPath = argv[++i];
+        else if (sArg == "--engine" && bHasValue) sEngine = argv[++i];
+        else if (sArg == "--sort") bSort = true;
+        else if (sArg == "--no-remove") bRemove = false;
+        else if (sArg == "--no-refine") bRefine = false;
+        else if (sArg == "--parallel-refine") bParallelRefine = true;
+        else if (sArg == "--threads" && bHasValue) iThreads = std::atoi(argv[++i]);
+        else if (sArg == "--point-limit" && bHasValue) iPointLimit = std::atoi(argv[++i]);
+        else if (sArg == "--stream" && bHasValue) iStreamCells = std::atoi(argv[++i]);
+        else if (sArg == "-q" || sArg == "--quiet") bQuiet = true;
+        else if (sArg == "-h" || sArg == "--help")
+        {
+            printUsage();
+            return 0;
+        }
+        else if (sArg[0] != '-' && sInputPath.empty()) sInputPath = sArg;
+        else
+        {
+            std::cerr << "Unknown or incomplete option " << sArg << "." << std::endl;
+            printUsage();
+            return 2;
+        }
+    }
+
+    if (sInputPath.empty() || (sEngine != "flip" && sEngine != "bw" && sEngine != "dc"))
+    {
+        printUsage();
+        return 2;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    // Out-of-core mode: finalize the point file, then triangulate the tagged stream straight to the output
+    if (iStreamCells > 0)
+    {
+        if (sOutputPath.empty())
+        {
+            std::cerr << "--stream needs an output path." << std::endl;
+            return 2;
+        }
+
+        const std::string sStreamPath = sOutputPath + ".stream";
+        {
+            std::ofstream stream(sStreamPath);
+            if (!StreamingMesh::finalizePointFile(sInputPath, stream, iStreamCells))
+            {
+                return 1;
+            }
+        }
+
+        std::ifstream stream(sStreamPath);
+        std::ofstream output(sOutputPath);
+        bool bOk = StreamingMesh::triangulateStream(stream, output);
+        std::remove(sStreamPath.c_str());
+
+        if (!bQuiet)
+        {
+            std::cerr << "streamed " << sInputPath << " to " << sOutputPath << " in " << secondsSince(start) << " s" << std::endl;
+        }
+        return bOk ? 0 : 1;
+    }
+
+    // Read the points
+    std::vector<Point> vecPt;
+    if (endsWith(sInputPath, ".bin"))
+    {
+        PointFile file;
+        if (!file.open(sInputPath))
+        {
+            return 1;
+        }
+        vecPt.assign(file.begin(), file.end());
+    }
+    else if (!loadPointText(sInputPath, vecPt, iThreads))
+    {
+        return 1;
+    }
+
+    const size_t uInputPoints = vecPt.size();
+    if (uInputPoints < 3)
+    {
+        std::cerr << sInputPath << " has fewer than three points." << std::endl;
+        return 1;
+    }
+
+    const double dLoadSeconds = secondsSince(start);
+
+    Mesh mesh(std::move(vecPt));
+    mesh.setSpatialSort(bSort);
+    mesh.setInsertionEngine(sEngine == "bw" ? InsertionEngine::BowyerWatson : InsertionEngine::SplitAndFlip);
+    mesh.setParallelBuild(sEngine == "dc", iThreads);
+    mesh.setParallelRefinement(bParallelRefine, iThreads);
+    mesh.setRefinementPointLimit(iPointLimit);
+
+    // Build, remove the helper triangles and refine
+    start = std::chrono::steady_clock::now();
+    mesh.setTriVector({ mesh.superTriangle() });
+    mesh.buildMesh();
+    const double dBuildSeconds = secondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    if (bRemove)
+    {
+        mesh.removeHelperTriangles();
+    }
+    const double dRemoveSeconds = secondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    if (bRefine && bRemove)
+    {
+        mesh.equilateralizeTriangles();
+    }
+    const double dRefineSeconds = secondsSince(start);
+
+    // Write the mesh
+    start = std::chrono::steady_clock::now();
+    bool bWritten = true;
+    CompactMesh compact;
+    if (!sOutputPath.empty())
+    {
+        compact = mesh.toCompact();
+        if (endsWith(sOutputPath, ".obj")) bWritten = writeObj(sOutputPath, compact);
+        else if (endsWith(sOutputPath, ".ply")) bWritten = writePly(sOutputPath, compact);
+        else if (endsWith(sOutputPath, ".node")) bWritten = writeTriangleFiles(sOutputPath.substr(0, sOutputPath.size() - 5), compact);
+        else bWritten = writeMeshBinary(sOutputPath, compact);
+    }
+    const double dWriteSeconds = secondsSince(start);
+
+    if (!bQuiet)
+    {
+        std::cerr << "points " << uInputPoints << " -> " << mesh.getShapeView().size() << ", triangles " << mesh.getTriView().size() << "\n"
+                  << "load " << dLoadSeconds << " s, build " << dBuildSeconds << " s, remove " << dRemoveSeconds
+                  << " s, refine " << dRefineSeconds << " s, write " << dWriteSeconds << " s" << std::endl;
+    }
+
+    return bWritten ? 0 : 1;
+}
@@ -0,0 +1,598 @@
+#include "compactmesh.h"
+#include "predicates.h"
+#include "spatialsort.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+// Enlargement of the super triangle used by triangulate, relative to the radius of the bounding box
+static const double SUPER_TRIANGLE_SCALE = 1.0e3;
+
+// Default constructor: creates an empty mesh
+CompactMesh::CompactMesh() {}
+
+// Constructor: copies the points and the triangles of a neighbour-indexed triangle list
+CompactMesh::CompactMesh(const std::vector<Point>& vecPt, const std::vector<Triangle>& vecTri)
+{
+    reserve(vecPt.size(), vecTri.size());
+
+    for (const Point& pt : vecPt)
+    {
+        addPoint(pt);
+    }
+
+    for (const Triangle& tri : vecTri)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            vecVertices.push_back(tri.getPointIndex(i));
+            vecNeighbours.push_back(tri.getNeighbourIndex(i));
+        }
+    }
+}
+
+// Takes over point and triangle arrays
+CompactMesh::CompactMesh(std::vector<float>&& vecX, std::vector<float>&& vecY, std::vector<int>&& vecVertices, std::vector<int>&& vecNeighbours)
+    : vecX(std::move(vecX)), vecY(std::move(vecY)), vecVertices(std::move(vecVertices)), vecNeighbours(std::move(vecNeighbours))
+{
+}
+
+// Computes the Delaunay triangulation of a set of points.
+// The points are inserted into a large super triangle, optionally in BRIO / Hilbert order, and every
+// triangle touching the super triangle is dropped at the end.
+CompactMesh CompactMesh::triangulate(const std::vector<Point>& vecPt, bool bSpatialSort)
+{
+    CompactMesh mesh;
+    int iPointCount = vecPt.size();
+
+    // Euler bound: a triangulation of n points has fewer than 2n + 1 triangles
+    mesh.reserve(iPointCount + 3, 2 * iPointCount + 1);
+    for (const Point& pt : vecPt)
+    {
+        mesh.addPoint(pt);
+    }
+
+    if (iPointCount == 0)
+    {
+        return mesh;
+    }
+
+    // Bounding box of the input points
+    double dMinX = vecPt[0].getX(), dMaxX = dMinX;
+    double dMinY = vecPt[0].getY(), dMaxY = dMinY;
+    for (const Point& pt : vecPt)
+    {
+        dMinX = std::min(dMinX, static_cast<double>(pt.getX()));
+        dMaxX = std::max(dMaxX, static_cast<double>(pt.getX()));
+        dMinY = std::min(dMinY, static_cast<double>(pt.getY()));
+        dMaxY = std::max(dMaxY, static_cast<double>(pt.getY()));
+    }
+
+    double dCenterX = 0.5 * (dMinX + dMaxX);
+    double dCenterY = 0.5 * (dMinY + dMaxY);
+    double dRadius = 0.5 * std::sqrt((dMaxX - dMinX) * (dMaxX - dMinX) + (dMaxY - dMinY) * (dMaxY - dMinY));
+    if (dRadius == 0)
+    {
+        dRadius = 1.0; // All points coincide
+    }
+    dRadius *= SUPER_TRIANGLE_SCALE;
+
+    // Equilateral super triangle circumscribing the enlarged circle, in counter-clockwise order
+    const double dSqrt3 = std::sqrt(3.0);
+    int iSuper0 = mesh.addPoint(Point(dCenterX - dSqrt3 * dRadius, dCenterY - dRadius));
+    int iSuper1 = mesh.addPoint(Point(dCenterX + dSqrt3 * dRadius, dCenterY - dRadius));
+    int iSuper2 = mesh.addPoint(Point(dCenterX, dCenterY + 2.0 * dRadius));
+    mesh.addTriangle(iSuper0, iSuper1, iSuper2);
+
+    std::vector<int> vecOrder;
+    if (bSpatialSort)
+    {
+        vecOrder = brioOrder(vecPt, iPointCount, 0);
+    }
+    else
+    {
+        vecOrder.resize(iPointCount);
+        for (int i = 0; i < iPointCount; ++i)
+        {
+            vecOrder[i] = i;
+        }
+    }
+
+    // Start each walk from a triangle incident to the previously inserted point
+    int iHint = 0;
+    for (int iPointIndex : vecOrder)
+    {
+        int iTriangleIndex = mesh.findContainingTriangle(vecPt[iPointIndex], iHint);
+        if (iTriangleIndex == -1)
+        {
+            continue;
+        }
+
+        int iIncident = mesh.insertPoint(iPointIndex, iTriangleIndex);
+        if (iIncident != -1)
+        {
+            iHint = iIncident;
+        }
+    }
+
+    // Drop the triangles touching the super triangle in a single pass, remapping the neighbour indices
+    int iTriangleCount = mesh.getTriangleCount();
+    std::vector<int> vecRemap(iTriangleCount, -1);
+    int iKept = 0;
+    for (int i = 0; i < iTriangleCount; ++i)
+    {
+        bool bHelper = false;
+        for (int j = 0; j < 3; ++j)
+        {
+            bHelper = bHelper || mesh.vecVertices[3 * i + j] >= iPointCount;
+        }
+
+        if (!bHelper)
+        {
+            vecRemap[i] = iKept++;
+        }
+    }
+
+    for (int i = 0; i < iTriangleCount; ++i)
+    {
+        int iNew = vecRemap[i];
+        if (iNew == -1)
+        {
+            continue;
+        }
+
+        for (int j = 0; j < 3; ++j)
+        {
+            int iNeighbour = mesh.vecNeighbours[3 * i + j];
+            mesh.vecVertices[3 * iNew + j] = mesh.vecVertices[3 * i + j];
+            mesh.vecNeighbours[3 * iNew + j] = iNeighbour == -1 ? -1 : vecRemap[iNeighbour];
+        }
+    }
+
+    mesh.vecVertices.resize(3 * iKept);
+    mesh.vecNeighbours.resize(3 * iKept);
+    mesh.vecX.resize(iPointCount);
+    mesh.vecY.resize(iPointCount);
+
+    return mesh;
+}
+
+// Returns the number of points
+int CompactMesh::getPointCount() const
+{
+    return vecX.size();
+}
+
+// Returns the number of triangles
+int CompactMesh::getTriangleCount() const
+{
+    return vecVertices.size() / 3;
+}
+
+// Returns a point of the mesh
+Point CompactMesh::getPoint(int iPointIndex) const
+{
+    return Point(vecX[iPointIndex], vecY[iPointIndex]);
+}
+
+// Returns the x coordinate of a point
+float CompactMesh::getX(int iPointIndex) const
+{
+    return vecX[iPointIndex];
+}
+
+// Returns the y coordinate of a point
+float CompactMesh::getY(int iPointIndex) const
+{
+    return vecY[iPointIndex];
+}
+
+// Returns the index of a point of a triangle
+int CompactMesh::getVertex(int iTriangleIndex, int iCorner) const
+{
+    return vecVertices[3 * iTriangleIndex + iCorner];
+}
+
+// Returns the index of the neighbour across an edge of a triangle
+int CompactMesh::getNeighbour(int iTriangleIndex, int iEdge) const
+{
+    return vecNeighbours[3 * iTriangleIndex + iEdge];
+}
+
+// Returns the x coordinates of all points
+const std::vector<float>& CompactMesh::getXArray() const
+{
+    return vecX;
+}
+
+// Returns the y coordinates of all points
+const std::vector<float>& CompactMesh::getYArray() const
+{
+    return vecY;
+}
+
+// Returns the point indices of all triangles
+const std::vector<int>& CompactMesh::getVertexArray() const
+{
+    return vecVertices;
+}
+
+// Returns the neighbour indices of all triangles
+const std::vector<int>& CompactMesh::getNeighbourArray() const
+{
+    return vecNeighbours;
+}
+
+// Reserves storage for a number of points and triangles
+void CompactMesh::reserve(int iPointCount, int iTriangleCount)
+{
+    vecX.reserve(iPointCount);
+    vecY.reserve(iPointCount);
+    vecVertices.reserve(3 * static_cast<std::size_t>(iTriangleCount));
+    vecNeighbours.reserve(3 * static_cast<std::size_t>(iTriangleCount));
+}
+
+// Appends a point and returns its index
+int CompactMesh::addPoint(const Point& pt)
+{
+    vecX.push_back(pt.getX());
+    vecY.push_back(pt.getY());
+    return vecX.size() - 1;
+}
+
+// Appends a triangle without neighbours and returns its index
+int CompactMesh::addTriangle(int iPointA, int iPointB, int iPointC)
+{
+    vecVertices.push_back(iPointA);
+    vecVertices.push_back(iPointB);
+    vecVertices.push_back(iPointC);
+
+    vecNeighbours.push_back(-1);
+    vecNeighbours.push_back(-1);
+    vecNeighbours.push_back(-1);
+
+    return getTriangleCount() - 1;
+}
+
+// Finds which edge of a triangle faces a given neighbour
+int CompactMesh::findNeighbourEdge(int iTriangleIndex, int iNeighbourIndex) const
+{
+    for (int i = 0; i < 3; ++i)
+    {
+        if (vecNeighbours[3 * iTriangleIndex + i] == iNeighbourIndex)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Redirects the neighbour reference of a triangle (no-op on the border)
+void CompactMesh::replaceNeighbour(int iTriangleIndex, int iOldNeighbour, int iNewNeighbour)
+{
+    if (iTriangleIndex == -1)
+    {
+        return;
+    }
+
+    int iEdge = findNeighbourEdge(iTriangleIndex, iOldNeighbour);
+    if (iEdge != -1)
+    {
+        vecNeighbours[3 * iTriangleIndex + iEdge] = iNewNeighbour;
+    }
+}
+
+// Finds the triangle containing a point.
+// The walk crosses an edge that separates the current triangle from the point, never going back through
+// the edge it entered by and rotating the first edge tested to break cycles on non-Delaunay meshes.
+int CompactMesh::findContainingTriangle(const Point& pt, int iStartIndex) const
+{
+    int iTriangleCount = getTriangleCount();
+    if (iTriangleCount == 0)
+    {
+        return -1;
+    }
+
+    int iCurrent = (iStartIndex >= 0 && iStartIndex < iTriangleCount) ? iStartIndex : 0;
+    int iEntryEdge = -1;
+
+    for (int iStep = 0; iStep <= iTriangleCount; ++iStep)
+    {
+        const int* aiVertices = &vecVertices[3 * iCurrent];
+        int iExitEdge = -1;
+
+        for (int i = 0; i < 3; ++i)
+        {
+            int iEdge = (iStep + i) % 3;
+            if (iEdge == iEntryEdge)
+            {
+                continue;
+            }
+
+            int iA = aiVertices[iEdge];
+            int iB = aiVertices[(iEdge + 1) % 3];
+            if (orient2d(vecX[iA], vecY[iA], vecX[iB], vecY[iB], pt.getX(), pt.getY()) < 0)
+            {
+                iExitEdge = iEdge;
+                break;
+            }
+        }
+
+        if (iExitEdge == -1)
+        {
+            return iCurrent;
+        }
+
+        int iNext = vecNeighbours[3 * iCurrent + iExitEdge];
+        if (iNext == -1)
+        {
+            return -1; // The point lies outside of the mesh
+        }
+
+        iEntryEdge = findNeighbourEdge(iNext, iCurrent);
+        iCurrent = iNext;
+    }
+
+    // The walk did not converge: fall back to a linear scan
+    for (int i = 0; i < iTriangleCount; ++i)
+    {
+        const int* aiVertices = &vecVertices[3 * i];
+        bool bInside = true;
+        for (int j = 0; j < 3 && bInside; ++j)
+        {
+            int iA = aiVertices[j];
+            int iB = aiVertices[(j + 1) % 3];
+            bInside = orient2d(vecX[iA], vecY[iA], vecX[iB], vecY[iB], pt.getX(), pt.getY()) >= 0;
+        }
+
+        if (bInside)
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+// Checks whether the point opposite an edge lies outside the circumcircle of the triangle
+bool CompactMesh::isLocallyDelaunay(int iTriangleIndex, int iEdge) const
+{
+    int iNeighbour = vecNeighbours[3 * iTriangleIndex + iEdge];
+    if (iNeighbour == -1)
+    {
+        return true;
+    }
+
+    int iNeighbourEdge = findNeighbourEdge(iNeighbour, iTriangleIndex);
+    int iOpposite = vecVertices[3 * iNeighbour + (iNeighbourEdge + 2) % 3];
+
+    int iA = vecVertices[3 * iTriangleIndex];
+    int iB = vecVertices[3 * iTriangleIndex + 1];
+    int iC = vecVertices[3 * iTriangleIndex + 2];
+
+    return incircle(vecX[iA], vecY[iA], vecX[iB], vecY[iB], vecX[iC], vecY[iC], vecX[iOpposite], vecY[iOpposite]) <= 0;
+}
+
+// Flips the edge shared by a triangle and its neighbour.
+// With the triangle (a, b, c) and the neighbour (b, a, d) across edge a->b, the triangle becomes (c, a, d)
+// and the neighbour becomes (d, b, c); only the two outer neighbours whose owner changed are relinked.
+void CompactMesh::flipEdge(int iTriangleIndex, int iEdge)
+{
+    int iNeighbour = vecNeighbours[3 * iTriangleIndex + iEdge];
+    if (iNeighbour == -1)
+    {
+        return;
+    }
+
+    int iNeighbourEdge = findNeighbourEdge(iNeighbour, iTriangleIndex);
+
+    int* aiTri = &vecVertices[3 * iTriangleIndex];
+    int* aiAdj = &vecVertices[3 * iNeighbour];
+
+    int iA = aiTri[iEdge];
+    int iB = aiTri[(iEdge + 1) % 3];
+    int iC = aiTri[(iEdge + 2) % 3];
+    int iD = aiAdj[(iNeighbourEdge + 2) % 3];
+
+    int iOuterBC = vecNeighbours[3 * iTriangleIndex + (iEdge + 1) % 3];
+    int iOuterCA = vecNeighbours[3 * iTriangleIndex + (iEdge + 2) % 3];
+    int iOuterAD = vecNeighbours[3 * iNeighbour + (iNeighbourEdge + 1) % 3];
+    int iOuterDB = vecNeighbours[3 * iNeighbour + (iNeighbourEdge + 2) % 3];
+
+    aiTri[0] = iC;
+    aiTri[1] = iA;
+    aiTri[2] = iD;
+    vecNeighbours[3 * iTriangleIndex] = iOuterCA;
+    vecNeighbours[3 * iTriangleIndex + 1] = iOuterAD;
+    vecNeighbours[3 * iTriangleIndex + 2] = iNeighbour;
+
+    aiAdj[0] = iD;
+    aiAdj[1] = iB;
+    aiAdj[2] = iC;
+    vecNeighbours[3 * iNeighbour] = iOuterDB;
+    vecNeighbours[3 * iNeighbour + 1] = iOuterBC;
+    vecNeighbours[3 * iNeighbour + 2] = iTriangleIndex;
+
+    replaceNeighbour(iOuterAD, iNeighbour, iTriangleIndex);
+    replaceNeighbour(iOuterBC, iTriangleIndex, iNeighbour);
+}
+
+// Flips queued edges until they are all locally Delaunay.
+// Every queued (triangle, edge) pair has the new point opposite the edge, so after a flip the two edges
+// that moved away from the point are queued in turn.
+int CompactMesh::legalize()
+{
+    int iFlipCount = 0;
+
+    while (!vecFlipStack.empty())
+    {
+        int iEdge = vecFlipStack.back();
+        vecFlipStack.pop_back();
+        int iTriangleIndex = vecFlipStack.back();
+        vecFlipStack.pop_back();
+
+        if (isLocallyDelaunay(iTriangleIndex, iEdge))
+        {
+            continue;
+        }
+
+        int iNeighbour = vecNeighbours[3 * iTriangleIndex + iEdge];
+        flipEdge(iTriangleIndex, iEdge);
+        ++iFlipCount;
+
+        vecFlipStack.push_back(iTriangleIndex);
+        vecFlipStack.push_back(1);
+        vecFlipStack.push_back(iNeighbour);
+        vecFlipStack.push_back(0);
+    }
+
+    return iFlipCount;
+}
+
+// Inserts a point into the triangle that contains it.
+// A point strictly inside splits the triangle into three; a point on an edge splits the two triangles
+// sharing that edge into four. The new edges are then legalized with Lawson flips.
+int CompactMesh::insertPoint(int iPointIndex, int iTriangleIndex)
+{
+    float fPx = vecX[iPointIndex];
+    float fPy = vecY[iPointIndex];
+
+    int aiCorner[3];
+    int iOnEdge = -1;
+    for (int i = 0; i < 3; ++i)
+    {
+        aiCorner[i] = vecVertices[3 * iTriangleIndex + i];
+        if (vecX[aiCorner[i]] == fPx && vecY[aiCorner[i]] == fPy)
+        {
+            return -1; // Duplicate point
+        }
+    }
+
+    for (int i = 0; i < 3 && iOnEdge == -1; ++i)
+    {
+        int iA = aiCorner[i];
+        int iB = aiCorner[(i + 1) % 3];
+        if (orient2d(vecX[iA], vecY[iA], vecX[iB], vecY[iB], fPx, fPy) == 0)
+        {
+            iOnEdge = i;
+        }
+    }
+
+    if (iOnEdge == -1)
+    {
+        // (a, b, c) -> (a, b, p), (b, c, p), (c, a, p)
+        int iA = aiCorner[0], iB = aiCorner[1], iC = aiCorner[2];
+        int iOuterBC = vecNeighbours[3 * iTriangleIndex + 1];
+        int iOuterCA = vecNeighbours[3 * iTriangleIndex + 2];
+
+        int iNew1 = addTriangle(iB, iC, iPointIndex);
+        int iNew2 = addTriangle(iC, iA, iPointIndex);
+
+        vecVertices[3 * iTriangleIndex + 2] = iPointIndex;
+        vecNeighbours[3 * iTriangleIndex + 1] = iNew1;
+        vecNeighbours[3 * iTriangleIndex + 2] = iNew2;
+
+        vecNeighbours[3 * iNew1] = iOuterBC;
+        vecNeighbours[3 * iNew1 + 1] = iNew2;
+        vecNeighbours[3 * iNew1 + 2] = iTriangleIndex;
+
+        vecNeighbours[3 * iNew2] = iOuterCA;
+        vecNeighbours[3 * iNew2 + 1] = iTriangleIndex;
+        vecNeighbours[3 * iNew2 + 2] = iNew1;
+
+        replaceNeighbour(iOuterBC, iTriangleIndex, iNew1);
+        replaceNeighbour(iOuterCA, iTriangleIndex, iNew2);
+
+        vecFlipStack.insert(vecFlipStack.end(), { iTriangleIndex, 0, iNew1, 0, iNew2, 0 });
+    }
+    else
+    {
+        // Triangle (a, b, c) with p on a->b, neighbour (b, a, d):
+        // (c, a, p), (b, c, p) on this side and (a, d, p), (d, b, p) on the other
+        int iA = aiCorner[iOnEdge];
+        int iB = aiCorner[(iOnEdge + 1) % 3];
+        int iC = aiCorner[(iOnEdge + 2) % 3];
+        int iOuterBC = vecNeighbours[3 * iTriangleIndex + (iOnEdge + 1) % 3];
+        int iOuterCA = vecNeighbours[3 * iTriangleIndex + (iOnEdge + 2) % 3];
+        int iNeighbour = vecNeighbours[3 * iTriangleIndex + iOnEdge];
+
+        int iNew1 = addTriangle(iB, iC, iPointIndex);
+        int iNewNeighbour = -1;
+
+        if (iNeighbour != -1)
+        {
+            int iNeighbourEdge = findNeighbourEdge(iNeighbour, iTriangleIndex);
+            int iD = vecVertices[3 * iNeighbour + (iNeighbourEdge + 2) % 3];
+            int iOuterAD = vecNeighbours[3 * iNeighbour + (iNeighbourEdge + 1) % 3];
+            int iOuterDB = vecNeighbours[3 * iNeighbour + (iNeighbourEdge + 2) % 3];
+
+            iNewNeighbour = addTriangle(iD, iB, iPointIndex);
+
+            vecVertices[3 * iNeighbour] = iA;
+            vecVertices[3 * iNeighbour + 1] = iD;
+            vecVertices[3 * iNeighbour + 2] = iPointIndex;
+            vecNeighbours[3 * iNeighbour] = iOuterAD;
+            vecNeighbours[3 * iNeighbour + 1] = iNewNeighbour;
+            vecNeighbours[3 * iNeighbour + 2] = iTriangleIndex;
+
+            vecNeighbours[3 * iNewNeighbour] = iOuterDB;
+            vecNeighbours[3 * iNewNeighbour + 1] = iNew1;
+            vecNeighbours[3 * iNewNeighbour + 2] = iNeighbour;
+
+            replaceNeighbour(iOuterDB, iNeighbour, iNewNeighbour);
+        }
+
+        vecVertices[3 * iTriangleIndex] = iC;
+        vecVertices[3 * iTriangleIndex + 1] = iA;
+        vecVertices[3 * iTriangleIndex + 2] = iPointIndex;
+        vecNeighbours[3 * iTriangleIndex] = iOuterCA;
+        vecNeighbours[3 * iTriangleIndex + 1] = iNeighbour;
+        vecNeighbours[3 * iTriangleIndex + 2] = iNew1;
+
+        vecNeighbours[3 * iNew1] = iOuterBC;
+        vecNeighbours[3 * iNew1 + 1] = iTriangleIndex;
+        vecNeighbours[3 * iNew1 + 2] = iNewNeighbour;
+
+        replaceNeighbour(iOuterBC, iTriangleIndex, iNew1);
+
+        vecFlipStack.insert(vecFlipStack.end(), { iTriangleIndex, 0, iNew1, 0 });
+        if (iNeighbour != -1)
+        {
+            vecFlipStack.insert(vecFlipStack.end(), { iNeighbour, 0, iNewNeighbour, 0 });
+        }
+    }
+
+    legalize();
+
+    return iTriangleIndex;
+}
+
+// Converts the mesh to a list of Triangle objects with point and neighbour indices
+std::vector<Triangle> CompactMesh::toTriangles() const
+{
+    int iTriangleCount = getTriangleCount();
+    std::vector<Triangle> vecTri;
+    vecTri.reserve(iTriangleCount);
+
+    for (int i = 0; i < iTriangleCount; ++i)
+    {
+        Triangle tri(getPoint(vecVertices[3 * i]), getPoint(vecVertices[3 * i + 1]), getPoint(vecVertices[3 * i + 2]));
+        for (int j = 0; j < 3; ++j)
+        {
+            int iNeighbour = vecNeighbours[3 * i + j];
+            tri.setPointIndex(j, vecVertices[3 * i + j]);
+            tri.setNeighbourCorner(j, iNeighbour == -1 ? -1 : 3 * iNeighbour + findNeighbourEdge(iNeighbour, i));
+        }
+        tri.setIndex(i);
+        vecTri.push_back(tri);
+    }
+
+    return vecTri;
+}
+
+// Returns the number of bytes held by the point and triangle arrays
+std::size_t CompactMesh::getMemoryUsage() const
+{
+    return (vecX.capacity() + vecY.capacity()) * sizeof(float) +
+           (vecVertices.capacity() + vecNeighbours.capacity()) * sizeof(int);
+}
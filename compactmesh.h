@@ -0,0 +1,93 @@
+#ifndef COMPACTMESH_H
+#define COMPACTMESH_H
+
+#include "point.h"
+#include "triangle.h"
+#include <cstddef>
+#include <vector>
+
+// Class representing a triangle mesh in structure-of-arrays form.
+// Coordinates are stored once per point in separate x and y arrays, and triangles hold nothing but
+// the indices of their points and neighbours (24 bytes per triangle). Triangles are counter-clockwise,
+// and neighbour i lies across the edge from point i to point (i + 1) % 3 (-1 on the border).
+class CompactMesh {
+
+private:
+    std::vector<float> vecX, vecY;  // Point coordinates
+    std::vector<int> vecVertices;  // Point indices, three per triangle
+    std::vector<int> vecNeighbours;  // Neighbouring triangle indices, three per triangle
+
+    std::vector<int> vecFlipStack;  // Scratch stack of (triangle, edge) pairs waiting for a Delaunay check
+
+    // Function to find which edge of a triangle faces a given neighbour (-1 if they are not adjacent)
+    int findNeighbourEdge(int iTriangleIndex, int iNeighbourIndex) const;
+
+    // Function to redirect the neighbour reference of a triangle from one triangle to another
+    void replaceNeighbour(int iTriangleIndex, int iOldNeighbour, int iNewNeighbour);
+
+    // Function to flip edges until every edge queued in vecFlipStack is locally Delaunay
+    int legalize();
+
+public:
+    // Default constructor: creates an empty mesh
+    CompactMesh();
+
+    // Constructor to copy the points and the triangles of a neighbour-indexed triangle list
+    CompactMesh(const std::vector<Point>& vecPt, const std::vector<Triangle>& vecTri);
+
+    // Constructor to take over point and triangle arrays laid out like the arrays returned by the getters below
+    CompactMesh(std::vector<float>&& vecX, std::vector<float>&& vecY, std::vector<int>&& vecVertices, std::vector<int>&& vecNeighbours);
+
+    // Function to compute the Delaunay triangulation of a set of points
+    static CompactMesh triangulate(const std::vector<Point>& vecPt, bool bSpatialSort = true);
+
+    // Getters for the size of the mesh
+    int getPointCount() const;
+    int getTriangleCount() const;
+
+    // Getters for the points
+    Point getPoint(int iPointIndex) const;
+    float getX(int iPointIndex) const;
+    float getY(int iPointIndex) const;
+
+    // Getters for the point and neighbour indices of a triangle
+    int getVertex(int iTriangleIndex, int iCorner) const;
+    int getNeighbour(int iTriangleIndex, int iEdge) const;
+
+    // Getters for the underlying arrays
+    const std::vector<float>& getXArray() const;
+    const std::vector<float>& getYArray() const;
+    const std::vector<int>& getVertexArray() const;
+    const std::vector<int>& getNeighbourArray() const;
+
+    // Function to reserve storage for a number of points and triangles
+    void reserve(int iPointCount, int iTriangleCount);
+
+    // Function to append a point and return its index
+    int addPoint(const Point& pt);
+
+    // Function to append a counter-clockwise triangle without neighbours and return its index
+    int addTriangle(int iPointA, int iPointB, int iPointC);
+
+    // Function to find the triangle that contains a point with a visibility walk (-1 if it is outside the mesh)
+    int findContainingTriangle(const Point& pt, int iStartIndex = 0) const;
+
+    // Function to check whether an edge satisfies the empty circumcircle property
+    bool isLocallyDelaunay(int iTriangleIndex, int iEdge) const;
+
+    // Function to flip the edge shared by a triangle and its neighbour across the given edge
+    void flipEdge(int iTriangleIndex, int iEdge);
+
+    // Function to insert a point into the triangle that contains it and restore the Delaunay property
+    // (returns the index of a triangle incident to the point, or -1 if the point duplicates a vertex)
+    int insertPoint(int iPointIndex, int iTriangleIndex);
+
+    // Function to convert the mesh back to a list of Triangle objects
+    std::vector<Triangle> toTriangles() const;
+
+    // Function to get the number of bytes held by the point and triangle arrays
+    std::size_t getMemoryUsage() const;
+
+};
+
+#endif // COMPACTMESH_H
@@ -0,0 +1,319 @@
+#include "mesh.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+// Point distributions of the benchmark
+static const char* const DISTRIBUTIONS[] = { "uniform", "clusters", "grid", "circle", "strip" };
+
+// Generates iCount points of a named distribution with a fixed seed
+static std::vector<Point> generatePoints(const std::string& sDistribution, int iCount)
+{
+    std::mt19937 gen(12345);
+    std::vector<Point> vecPt;
+    vecPt.reserve(iCount);
+
+    if (sDistribution == "uniform")
+    {
+        // Uniform random points in a square
+        std::uniform_real_distribution<float> dis(0.0f, 1000.0f);
+        for (int i = 0; i < iCount; ++i)
+        {
+            vecPt.emplace_back(dis(gen), dis(gen));
+        }
+    }
+    else if (sDistribution == "clusters")
+    {
+        // Gaussian clusters around 16 random centres
+        std::uniform_real_distribution<float> disCentre(100.0f, 900.0f);
+        std::vector<Point> vecCentres;
+        for (int i = 0; i < 16; ++i)
+        {
+            vecCentres.emplace_back(disCentre(gen), disCentre(gen));
+        }
+
+        std::normal_distribution<float> dis(0.0f, 20.0f);
+        for (int i = 0; i < iCount; ++i)
+        {
+            const Point& ptCentre = vecCentres[i % vecCentres.size()];
+            vecPt.emplace_back(ptCentre.getX() + dis(gen), ptCentre.getY() + dis(gen));
+        }
+    }
+    else if (sDistribution == "grid")
+    {
+        // Regular grid, where every cell has four cocircular points (testCaseRect scaled up)
+        const int iSide = std::max(2, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(iCount)))));
+        for (int i = 0; i < iCount; ++i)
+        {
+            vecPt.emplace_back(static_cast<float>(i % iSide), static_cast<float>(i / iSide));
+        }
+    }
+    else if (sDistribution == "circle")
+    {
+        // Points on a circle, all (nearly) cocircular
+        const double dStep = 2.0 * 3.14159265358979323846 / iCount;
+        for (int i = 0; i < iCount; ++i)
+        {
+            vecPt.emplace_back(static_cast<float>(500.0 + 500.0 * std::cos(i * dStep)), static_cast<float>(500.0 + 500.0 * std::sin(i * dStep)));
+        }
+    }
+    else if (sDistribution == "strip")
+    {
+        // Narrow strip with an aspect ratio of 1000
+        std::uniform_real_distribution<float> disX(0.0f, 1000.0f);
+        std::uniform_real_distribution<float> disY(0.0f, 1.0f);
+        for (int i = 0; i < iCount; ++i)
+        {
+            vecPt.emplace_back(disX(gen), disY(gen));
+        }
+    }
+
+    return vecPt;
+}
+
+// Resets the peak resident set size of the process where the platform allows it (Linux only)
+static void resetPeakRss()
+{
+#ifdef __linux__
+    if (std::FILE* pFile = std::fopen("/proc/self/clear_refs", "w"))
+    {
+        std::fputs("5", pFile);
+        std::fclose(pFile);
+    }
+#endif
+}
+
+// Returns the peak resident set size of the process in bytes (since the last reset on Linux)
+static long long getPeakRss()
+{
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    {
+        return static_cast<long long>(counters.PeakWorkingSetSize);
+    }
+    return 0;
+#else
+#ifdef __linux__
+    if (std::FILE* pFile = std::fopen("/proc/self/status", "r"))
+    {
+        char acLine[256];
+        long long lKilobytes = -1;
+        while (std::fgets(acLine, sizeof(acLine), pFile))
+        {
+            if (std::strncmp(acLine, "VmHWM:", 6) == 0)
+            {
+                lKilobytes = std::atoll(acLine + 6);
+                break;
+            }
+        }
+        std::fclose(pFile);
+        if (lKilobytes >= 0)
+        {
+            return lKilobytes * 1024;
+        }
+    }
+#endif
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return static_cast<long long>(usage.ru_maxrss);
+#else
+    return static_cast<long long>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+// Returns the seconds elapsed since a time point
+static double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Splits a comma separated list
+static std::vector<std::string> splitList(const std::string& sList)
+{
+    std::vector<std::string> vecItems;
+    std::stringstream stream(sList);
+    std::string sItem;
+    while (std::getline(stream, sItem, ','))
+    {
+        if (!sItem.empty())
+        {
+            vecItems.push_back(sItem);
+        }
+    }
+    return vecItems;
+}
+
+// Settings shared by every benchmark case
+struct BenchOptions {
+    std::string sEngine{"flip"};  // Insertion engine: flip, bw or dc
+    bool bSort{true};  // Whether the points are inserted in BRIO / Hilbert order
+    bool bRefine{true};  // Whether equilateralizeTriangles is timed
+    bool bParallelRefine{false};  // Whether the refinement runs conflict-free batches in parallel
+    int iThreads{0};  // Number of threads of the parallel engines
+};
+
+// Runs the three phases on one distribution and size and writes the results as a JSON object
+static void runCase(const std::string& sDistribution, int iCount, const BenchOptions& options, std::ostream& json)
+{
+    resetPeakRss();
+
+    std::vector<Point> vecPt = generatePoints(sDistribution, iCount);
+
+    Mesh mesh(std::move(vecPt));
+    mesh.setSpatialSort(options.bSort);
+    mesh.setInsertionEngine(options.sEngine == "bw" ? InsertionEngine::BowyerWatson : InsertionEngine::SplitAndFlip);
+    mesh.setParallelBuild(options.sEngine == "dc", options.iThreads);
+    mesh.setParallelRefinement(options.bParallelRefine, options.iThreads);
+
+    // Build
+    auto start = std::chrono::steady_clock::now();
+    mesh.setTriVector({ mesh.superTriangle() });
+    mesh.buildMesh();
+    const double dBuildSeconds = secondsSince(start);
+    const long long lBuildTriangles = mesh.getTriView().size();
+    const long long lBuildFlips = mesh.stats().lFlips;
+
+    // Remove the helper triangles
+    start = std::chrono::steady_clock::now();
+    mesh.removeHelperTriangles();
+    const double dRemoveSeconds = secondsSince(start);
+    const long long lTriangles = mesh.getTriView().size();
+
+    // Refine
+    const long long lPointsBefore = mesh.getShapeView().size();
+    double dRefineSeconds = 0.0;
+    if (options.bRefine)
+    {
+        start = std::chrono::steady_clock::now();
+        mesh.equilateralizeTriangles();
+        dRefineSeconds = secondsSince(start);
+    }
+    const long long lRefinePoints = static_cast<long long>(mesh.getShapeView().size()) - lPointsBefore;
+    const long long lRefineTriangles = mesh.getTriView().size();
+    const long long lRefineFlips = mesh.stats().lFlips - lBuildFlips;
+
+    const long long lPeakRss = getPeakRss();
+    const MeshStats stats = mesh.stats();
+
+    json << "    {\"distribution\": \"" << sDistribution << "\", \"points\": " << iCount
+         << ",\n     \"build\": {\"seconds\": " << dBuildSeconds
+         << ", \"points_per_second\": " << (dBuildSeconds > 0.0 ? iCount / dBuildSeconds : 0.0)
+         << ", \"triangles\": " << lBuildTriangles
+         << ", \"triangles_per_second\": " << (dBuildSeconds > 0.0 ? lBuildTriangles / dBuildSeconds : 0.0)
+         << ", \"flips\": " << lBuildFlips << "}"
+         << ",\n     \"remove\": {\"seconds\": " << dRemoveSeconds << ", \"triangles\": " << lTriangles << "}"
+         << ",\n     \"refine\": {\"seconds\": " << dRefineSeconds
+         << ", \"points_added\": " << lRefinePoints
+         << ", \"points_per_second\": " << (dRefineSeconds > 0.0 ? lRefinePoints / dRefineSeconds : 0.0)
+         << ", \"triangles\": " << lRefineTriangles
+         << ", \"triangles_per_second\": " << (dRefineSeconds > 0.0 ? lRefineTriangles / dRefineSeconds : 0.0)
+         << ", \"flips\": " << lRefineFlips << "}"
+         << ",\n     \"counters\": {\"walk_steps\": " << stats.lWalkSteps << ", \"incircle_tests\": " << stats.lIncircleTests
+         << ", \"edge_case_splits\": " << stats.lEdgeCaseSplits << ", \"triangles_allocated\": " << stats.lTrianglesAllocated << "}"
+         << ",\n     \"peak_rss_bytes\": " << lPeakRss << "}";
+
+    std::cerr << sDistribution << " " << iCount << ": build " << dBuildSeconds << " s, remove " << dRemoveSeconds
+              << " s, refine " << dRefineSeconds << " s, " << lRefineTriangles << " triangles, peak RSS "
+              << lPeakRss / (1024 * 1024) << " MB" << std::endl;
+}
+
+// End-to-end benchmark of buildMesh, removeHelperTriangles and equilateralizeTriangles on canonical point
+// distributions, written as JSON so that runs can be compared across commits.
+// Usage: delaunay_bench [--sizes 1000,10000,...] [--distributions uniform,clusters,...] [--engine flip|bw|dc]
+//                       [--no-sort] [--no-refine] [--parallel-refine] [--threads n] [--label text] [-o results.json]
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> vecSizes = { "1000", "10000", "100000", "1000000", "10000000" };
+    std::vector<std::string> vecDistributions(std::begin(DISTRIBUTIONS), std::end(DISTRIBUTIONS));
+    BenchOptions options;
+    std::string sLabel, sOutputPath;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string sArg = argv[i];
+        const bool bHasValue = i + 1 < argc;
+
+        if (sArg == "--sizes" && bHasValue) vecSizes = splitList(argv[++i]);
+        else if (sArg == "--distributions" && bHasValue) vecDistributions = splitList(argv[++i]);
+        else if (sArg == "--engine" && bHasValue) options.sEngine = argv[++i];
+        else if (sArg == "--no-sort") options.bSort = false;
+        else if (sArg == "--no-refine") options.bRefine = false;
+        else if (sArg == "--parallel-refine") options.bParallelRefine = true;
+        else if (sArg == "--threads" && bHasValue) options.iThreads = std::atoi(argv[++i]);
+        else if (sArg == "--label" && bHasValue) sLabel = argv[++i];
+        else if ((sArg == "-o" || sArg == "--output") && bHasValue) sOutputPath = argv[++i];
+        else
+        {
+            std::cerr << "Unknown or incomplete option " << sArg << "." << std::endl;
+            return 2;
+        }
+    }
+
+    for (const std::string& sDistribution : vecDistributions)
+    {
+        if (std::find(std::begin(DISTRIBUTIONS), std::end(DISTRIBUTIONS), sDistribution) == std::end(DISTRIBUTIONS))
+        {
+            std::cerr << "Unknown distribution " << sDistribution << "." << std::endl;
+            return 2;
+        }
+    }
+
+    std::ostringstream json;
+    json.precision(9);
+    json << "{\n  \"label\": \"" << sLabel << "\", \"engine\": \"" << options.sEngine
+         << "\", \"spatial_sort\": " << (options.bSort ? "true" : "false")
+         << ", \"parallel_refinement\": " << (options.bParallelRefine ? "true" : "false")
+         << ", \"threads\": " << options.iThreads << ",\n  \"results\": [\n";
+
+    bool bFirst = true;
+    for (const std::string& sDistribution : vecDistributions)
+    {
+        for (const std::string& sSize : vecSizes)
+        {
+            if (!bFirst)
+            {
+                json << ",\n";
+            }
+            bFirst = false;
+            runCase(sDistribution, std::atoi(sSize.c_str()), options, json);
+        }
+    }
+    json << "\n  ]\n}\n";
+
+    if (sOutputPath.empty())
+    {
+        std::cout << json.str();
+        return 0;
+    }
+
+    std::ofstream output(sOutputPath);
+    output << json.str();
+    if (!output)
+    {
+        std::cerr << "Failed to write " << sOutputPath << "." << std::endl;
+        return 1;
+    }
+    return 0;
+}
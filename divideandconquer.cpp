@@ -0,0 +1,418 @@
+#include "divideandconquer.h"
+#include "predicates.h"
+#include "parallel.h"
+#include <algorithm>
+#include <future>
+
+// Recursions below this number of sites are not split into parallel tasks
+static const int MIN_PARALLEL_SITES = 4096;
+
+// Prepares the triangulation of a subset of points
+DivideAndConquer::DivideAndConquer(const std::vector<Point>& vecPt, const std::vector<int>& vecPointIndices)
+    : vecPt(vecPt), vecSites(vecPointIndices)
+{
+}
+
+// Triangulates the points with the given indices
+std::vector<Triangle> DivideAndConquer::triangulate(const std::vector<Point>& vecPt, const std::vector<int>& vecPointIndices, int iThreadCount,
+                                                     const MeshCounters* pCounters)
+{
+    iThreadCount = resolveThreadCount(iThreadCount);
+
+    DivideAndConquer dc(vecPt, vecPointIndices);
+    dc.pCounters = pCounters;
+
+    // Sort the sites lexicographically and drop duplicate points, keeping the lowest index
+    dc.sortSites(0, dc.vecSites.size(), iThreadCount);
+    dc.vecSites.erase(std::unique(dc.vecSites.begin(), dc.vecSites.end(), [&vecPt](int iA, int iB) {
+        return vecPt[iA].getX() == vecPt[iB].getX() && vecPt[iA].getY() == vecPt[iB].getY();
+    }), dc.vecSites.end());
+
+    const int iSiteCount = dc.vecSites.size();
+    if (iSiteCount < 3)
+    {
+        return {};
+    }
+
+    dc.vecX.resize(iSiteCount);
+    dc.vecY.resize(iSiteCount);
+    for (int i = 0; i < iSiteCount; ++i)
+    {
+        dc.vecX[i] = vecPt[dc.vecSites[i]].getX();
+        dc.vecY[i] = vecPt[dc.vecSites[i]].getY();
+    }
+
+    // Three quad-edges per site; each recursion initializes the block of its own sites
+    dc.vecNext.resize(12 * static_cast<size_t>(iSiteCount));
+    dc.vecOrigin.resize(6 * static_cast<size_t>(iSiteCount));
+
+    FreeList freeList;
+    dc.build(0, iSiteCount, freeList, iThreadCount);
+
+    return dc.toTriangles(iThreadCount);
+}
+
+// Checks whether sites A, B, C are counter-clockwise
+bool DivideAndConquer::ccw(int iA, int iB, int iC) const
+{
+    return orient2d(vecX[iA], vecY[iA], vecX[iB], vecY[iB], vecX[iC], vecY[iC]) > 0;
+}
+
+// Checks whether a site lies strictly right of a directed edge
+bool DivideAndConquer::rightOf(int iSite, int iEdge) const
+{
+    return ccw(iSite, dest(iEdge), org(iEdge));
+}
+
+// Checks whether a site lies strictly left of a directed edge
+bool DivideAndConquer::leftOf(int iSite, int iEdge) const
+{
+    return ccw(iSite, org(iEdge), dest(iEdge));
+}
+
+// Checks whether site D lies strictly inside the circle through the counter-clockwise sites A, B, C
+bool DivideAndConquer::inCircle(int iA, int iB, int iC, int iD) const
+{
+    if (pCounters)
+    {
+        pCounters->add(MeshCounter::IncircleTests);
+    }
+    return incircle(vecX[iA], vecY[iA], vecX[iB], vecY[iB], vecX[iC], vecY[iC], vecX[iD], vecY[iD]) > 0;
+}
+
+// Creates an isolated edge from one site to another, taking its quad-edge from the free list
+int DivideAndConquer::makeEdge(int iOrigin, int iDestination, FreeList& freeList)
+{
+    const int iQuad = freeList.iHead;
+    freeList.iHead = vecNext[4 * iQuad];
+    if (freeList.iHead == -1)
+    {
+        freeList.iTail = -1;
+    }
+
+    const int iEdge = 4 * iQuad;
+    vecNext[iEdge] = iEdge;
+    vecNext[iEdge + 1] = iEdge + 3;
+    vecNext[iEdge + 2] = iEdge + 2;
+    vecNext[iEdge + 3] = iEdge + 1;
+    vecOrigin[2 * iQuad] = iOrigin;
+    vecOrigin[2 * iQuad + 1] = iDestination;
+    return iEdge;
+}
+
+// Joins or separates the edge rings of the origins of A and B (and the rings of their left faces)
+void DivideAndConquer::splice(int iA, int iB)
+{
+    const int iAlpha = rot(vecNext[iA]);
+    const int iBeta = rot(vecNext[iB]);
+
+    std::swap(vecNext[iA], vecNext[iB]);
+    std::swap(vecNext[iAlpha], vecNext[iBeta]);
+}
+
+// Adds an edge from the destination of A to the origin of B, so that A, the new edge and B share a left face
+int DivideAndConquer::connect(int iA, int iB, FreeList& freeList)
+{
+    const int iEdge = makeEdge(dest(iA), org(iB), freeList);
+    splice(iEdge, lnext(iA));
+    splice(sym(iEdge), iB);
+    return iEdge;
+}
+
+// Removes an edge from the subdivision and returns its quad-edge to the free list
+void DivideAndConquer::deleteEdge(int iEdge, FreeList& freeList)
+{
+    splice(iEdge, oprev(iEdge));
+    splice(sym(iEdge), oprev(sym(iEdge)));
+
+    const int iQuad = iEdge >> 2;
+    vecOrigin[2 * iQuad] = -1;
+    vecOrigin[2 * iQuad + 1] = -1;
+
+    vecNext[4 * iQuad] = freeList.iHead;
+    freeList.iHead = iQuad;
+    if (freeList.iTail == -1)
+    {
+        freeList.iTail = iQuad;
+    }
+}
+
+// Chains the quad-edges in [iFirst, iLast) into a free list
+void DivideAndConquer::initFreeList(int iFirst, int iLast, FreeList& freeList)
+{
+    for (int iQuad = iFirst; iQuad < iLast; ++iQuad)
+    {
+        vecNext[4 * iQuad] = iQuad + 1 < iLast ? iQuad + 1 : -1;
+        vecOrigin[2 * iQuad] = -1;
+        vecOrigin[2 * iQuad + 1] = -1;
+    }
+    freeList.iHead = iFirst < iLast ? iFirst : -1;
+    freeList.iTail = iFirst < iLast ? iLast - 1 : -1;
+}
+
+// Appends one free list to another
+void DivideAndConquer::joinFreeLists(FreeList& freeList, const FreeList& other)
+{
+    if (other.iHead == -1)
+    {
+        return;
+    }
+    if (freeList.iHead == -1)
+    {
+        freeList = other;
+        return;
+    }
+    vecNext[4 * freeList.iTail] = other.iHead;
+    freeList.iTail = other.iTail;
+}
+
+// Triangulates the sites in [iLo, iHi); the halves run as parallel tasks while threads are left
+DivideAndConquer::HullEdges DivideAndConquer::build(int iLo, int iHi, FreeList& freeList, int iThreadCount)
+{
+    const int iCount = iHi - iLo;
+
+    if (iCount <= 3)
+    {
+        initFreeList(3 * iLo, 3 * iHi, freeList);
+
+        const int iEdgeA = makeEdge(iLo, iLo + 1, freeList);
+        if (iCount == 2)
+        {
+            return { iEdgeA, sym(iEdgeA) };
+        }
+
+        const int iEdgeB = makeEdge(iLo + 1, iLo + 2, freeList);
+        splice(sym(iEdgeA), iEdgeB);
+
+        if (ccw(iLo, iLo + 1, iLo + 2))
+        {
+            connect(iEdgeB, iEdgeA, freeList);
+            return { iEdgeA, sym(iEdgeB) };
+        }
+        if (ccw(iLo, iLo + 2, iLo + 1))
+        {
+            const int iEdgeC = connect(iEdgeB, iEdgeA, freeList);
+            return { sym(iEdgeC), iEdgeC };
+        }
+
+        // The three sites are collinear
+        return { iEdgeA, sym(iEdgeB) };
+    }
+
+    // Split at the median so the subdivision does not depend on the number of threads
+    const int iMid = iLo + iCount / 2;
+
+    FreeList freeListRight;
+    HullEdges left, right;
+
+    if (iThreadCount > 1 && iCount >= MIN_PARALLEL_SITES)
+    {
+        const int iLeftThreads = iThreadCount / 2;
+        std::future<HullEdges> futureLeft = std::async(std::launch::async, [this, iLo, iMid, &freeList, iLeftThreads]() {
+            return build(iLo, iMid, freeList, iLeftThreads);
+        });
+        right = build(iMid, iHi, freeListRight, iThreadCount - iLeftThreads);
+        left = futureLeft.get();
+    }
+    else
+    {
+        left = build(iLo, iMid, freeList, 1);
+        right = build(iMid, iHi, freeListRight, 1);
+    }
+
+    joinFreeLists(freeList, freeListRight);
+
+    return merge(left, right, freeList);
+}
+
+// Merges two adjacent triangulations: the lower common tangent is found first, then the seam is
+// zipped upwards, deleting the edges that fail the empty circle test on either side
+DivideAndConquer::HullEdges DivideAndConquer::merge(HullEdges left, HullEdges right, FreeList& freeList)
+{
+    int iLdo = left.iLeft, iLdi = left.iRight;
+    int iRdi = right.iLeft, iRdo = right.iRight;
+
+    // Find the lower common tangent of the two hulls
+    while (true)
+    {
+        if (leftOf(org(iRdi), iLdi))
+        {
+            iLdi = lnext(iLdi);
+        }
+        else if (rightOf(org(iLdi), iRdi))
+        {
+            iRdi = rprev(iRdi);
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    int iBase = connect(sym(iRdi), iLdi, freeList);
+    if (org(iLdi) == org(iLdo))
+    {
+        iLdo = sym(iBase);
+    }
+    if (org(iRdi) == org(iRdo))
+    {
+        iRdo = iBase;
+    }
+
+    // Add cross edges from the bottom of the seam to the top
+    while (true)
+    {
+        // Candidate on the left side, deleting left edges whose circle contains the next candidate
+        int iLeftCandidate = onext(sym(iBase));
+        if (rightOf(dest(iLeftCandidate), iBase))
+        {
+            while (inCircle(dest(iBase), org(iBase), dest(iLeftCandidate), dest(onext(iLeftCandidate))))
+            {
+                const int iNext = onext(iLeftCandidate);
+                deleteEdge(iLeftCandidate, freeList);
+                iLeftCandidate = iNext;
+            }
+        }
+
+        // Same on the right side
+        int iRightCandidate = oprev(iBase);
+        if (rightOf(dest(iRightCandidate), iBase))
+        {
+            while (inCircle(dest(iBase), org(iBase), dest(iRightCandidate), dest(oprev(iRightCandidate))))
+            {
+                const int iPrev = oprev(iRightCandidate);
+                deleteEdge(iRightCandidate, freeList);
+                iRightCandidate = iPrev;
+            }
+        }
+
+        const bool bLeftValid = rightOf(dest(iLeftCandidate), iBase);
+        const bool bRightValid = rightOf(dest(iRightCandidate), iBase);
+
+        // The upper common tangent has been reached
+        if (!bLeftValid && !bRightValid)
+        {
+            break;
+        }
+
+        // Connect to the candidate whose circle is empty of the other one
+        if (!bLeftValid || (bRightValid && inCircle(dest(iLeftCandidate), org(iLeftCandidate), org(iRightCandidate), dest(iRightCandidate))))
+        {
+            iBase = connect(iRightCandidate, sym(iBase), freeList);
+        }
+        else
+        {
+            iBase = connect(sym(iBase), sym(iLeftCandidate), freeList);
+        }
+    }
+
+    return { iLdo, iRdo };
+}
+
+// Sorts the sites in [iLo, iHi) lexicographically (ties by point index); the halves of a median split are sorted in parallel
+void DivideAndConquer::sortSites(int iLo, int iHi, int iThreadCount)
+{
+    auto lessSite = [this](int iA, int iB) {
+        const Point& ptA = vecPt[iA];
+        const Point& ptB = vecPt[iB];
+        if (ptA.getX() != ptB.getX()) return ptA.getX() < ptB.getX();
+        if (ptA.getY() != ptB.getY()) return ptA.getY() < ptB.getY();
+        return iA < iB;
+    };
+
+    if (iThreadCount <= 1 || iHi - iLo < MIN_PARALLEL_SITES)
+    {
+        std::sort(vecSites.begin() + iLo, vecSites.begin() + iHi, lessSite);
+        return;
+    }
+
+    const int iMid = iLo + (iHi - iLo) / 2;
+    std::nth_element(vecSites.begin() + iLo, vecSites.begin() + iMid, vecSites.begin() + iHi, lessSite);
+
+    const int iLeftThreads = iThreadCount / 2;
+    std::future<void> futureLeft = std::async(std::launch::async, [this, iLo, iMid, iLeftThreads]() {
+        sortSites(iLo, iMid, iLeftThreads);
+    });
+    sortSites(iMid, iHi, iThreadCount - iLeftThreads);
+    futureLeft.get();
+}
+
+// Converts the subdivision to triangles. Every counter-clockwise face with three edges becomes a triangle,
+// numbered in the order of its smallest directed edge; the chunks of quad-edges are processed in parallel
+// and their triangle counts are turned into offsets, so the numbering does not depend on the thread count.
+std::vector<Triangle> DivideAndConquer::toTriangles(int iThreadCount) const
+{
+    const int iQuadCount = vecOrigin.size() / 2;
+    const int iChunkCount = std::max(1, std::min(iThreadCount, iQuadCount / MIN_PARALLEL_SITES));
+
+    // Corner (triangle * 3 + edge) of every primal directed edge, indexed like vecOrigin (-1 outside of triangles)
+    std::vector<int> vecCorner(vecOrigin.size(), -1);
+    std::vector<int> vecChunkTriangles(iChunkCount + 1, 0);
+
+    // Returns the three edges of the left face of a directed edge if it is a triangle owned by that edge
+    auto ownedTriangle = [this](int iEdge, int aiEdges[3]) {
+        aiEdges[0] = iEdge;
+        aiEdges[1] = lnext(iEdge);
+        aiEdges[2] = lnext(aiEdges[1]);
+        return lnext(aiEdges[2]) == iEdge && iEdge < aiEdges[1] && iEdge < aiEdges[2] &&
+               ccw(org(aiEdges[0]), org(aiEdges[1]), org(aiEdges[2]));
+    };
+
+    // Count the triangles owned by each chunk
+    parallelChunks(iQuadCount, iChunkCount, [&](int iBegin, int iEnd, int iChunk) {
+        int aiEdges[3];
+        for (int iQuad = iBegin; iQuad < iEnd; ++iQuad)
+        {
+            if (vecOrigin[2 * iQuad] == -1) continue;  // Free quad-edge
+            vecChunkTriangles[iChunk + 1] += ownedTriangle(4 * iQuad, aiEdges);
+            vecChunkTriangles[iChunk + 1] += ownedTriangle(4 * iQuad + 2, aiEdges);
+        }
+    });
+
+    for (int iChunk = 0; iChunk < iChunkCount; ++iChunk)
+    {
+        vecChunkTriangles[iChunk + 1] += vecChunkTriangles[iChunk];
+    }
+
+    std::vector<Triangle> vecTriangles(vecChunkTriangles[iChunkCount]);
+    std::vector<int> vecTriangleEdges(3 * vecTriangles.size());
+
+    // Number the triangles and label their edges
+    parallelChunks(iQuadCount, iChunkCount, [&](int iBegin, int iEnd, int iChunk) {
+        int iTriangleIndex = vecChunkTriangles[iChunk];
+        int aiEdges[3];
+        for (int iQuad = iBegin; iQuad < iEnd; ++iQuad)
+        {
+            if (vecOrigin[2 * iQuad] == -1) continue;  // Free quad-edge
+            for (int iEdge = 4 * iQuad; iEdge < 4 * iQuad + 4; iEdge += 2)
+            {
+                if (!ownedTriangle(iEdge, aiEdges)) continue;
+                for (int k = 0; k < 3; ++k)
+                {
+                    vecCorner[aiEdges[k] >> 1] = 3 * iTriangleIndex + k;
+                    vecTriangleEdges[3 * iTriangleIndex + k] = aiEdges[k];
+                }
+                ++iTriangleIndex;
+            }
+        }
+    });
+
+    // Build the triangles; the neighbour across an edge owns the reversed edge
+    parallelChunks(vecTriangles.size(), iChunkCount, [&](int iBegin, int iEnd, int) {
+        for (int iTriangleIndex = iBegin; iTriangleIndex < iEnd; ++iTriangleIndex)
+        {
+            Triangle& triangle = vecTriangles[iTriangleIndex];
+            triangle.setIndex(iTriangleIndex);
+            for (int k = 0; k < 3; ++k)
+            {
+                const int iEdge = vecTriangleEdges[3 * iTriangleIndex + k];
+                const int iPointIndex = vecSites[org(iEdge)];
+                triangle.setPoint(k, vecPt[iPointIndex]);
+                triangle.setPointIndex(k, iPointIndex);
+                triangle.setNeighbourCorner(k, vecCorner[sym(iEdge) >> 1]);
+            }
+        }
+    });
+
+    return vecTriangles;
+}
@@ -0,0 +1,90 @@
+#ifndef DIVIDEANDCONQUER_H
+#define DIVIDEANDCONQUER_H
+
+#include "point.h"
+#include "triangle.h"
+#include "meshstats.h"
+#include <vector>
+
+// Class computing a Delaunay triangulation with the Guibas-Stolfi divide-and-conquer algorithm.
+// The points are sorted lexicographically, split recursively at the median, and the two halves are
+// triangulated as parallel tasks before being merged along the seam between them. The subdivision is
+// held in quad-edge form: every recursion over m points owns a fixed block of 3m quad-edges, which is
+// enough because a planar graph never has more edges, so parallel tasks never share allocations.
+// The result does not depend on the number of threads.
+class DivideAndConquer {
+
+private:
+    const std::vector<Point>& vecPt;  // Points being triangulated
+    std::vector<int> vecSites;  // Indices of the points in lexicographic order, without duplicates
+    std::vector<double> vecX, vecY;  // Coordinates of the sites, in site order
+    const MeshCounters* pCounters{nullptr};  // Counters receiving the incircle tests (none if null)
+
+    std::vector<int> vecNext;  // Onext of every directed edge, four (primal, dual, primal reversed, dual reversed) per quad-edge
+    std::vector<int> vecOrigin;  // Origin site of the two primal directed edges of every quad-edge (-1 for a free quad-edge)
+
+    // List of free quad-edges, chained through the onext slot of their first directed edge
+    struct FreeList {
+        int iHead{-1};  // First free quad-edge (-1 if the list is empty)
+        int iTail{-1};  // Last free quad-edge
+    };
+
+    // Convex hull edges returned by a recursion: counter-clockwise out of the leftmost site, clockwise out of the rightmost one
+    struct HullEdges {
+        int iLeft;
+        int iRight;
+    };
+
+    // Quad-edge navigation
+    static int rot(int iEdge) { return (iEdge & ~3) | ((iEdge + 1) & 3); }
+    static int sym(int iEdge) { return (iEdge & ~3) | ((iEdge + 2) & 3); }
+    static int rotInv(int iEdge) { return (iEdge & ~3) | ((iEdge + 3) & 3); }
+    int onext(int iEdge) const { return vecNext[iEdge]; }
+    int oprev(int iEdge) const { return rot(vecNext[rot(iEdge)]); }
+    int lnext(int iEdge) const { return rot(vecNext[rotInv(iEdge)]); }
+    int rprev(int iEdge) const { return vecNext[sym(iEdge)]; }
+    int org(int iEdge) const { return vecOrigin[(iEdge >> 1)]; }
+    int dest(int iEdge) const { return vecOrigin[(sym(iEdge) >> 1)]; }
+
+    // Geometric tests on sites
+    bool ccw(int iA, int iB, int iC) const;
+    bool rightOf(int iSite, int iEdge) const;
+    bool leftOf(int iSite, int iEdge) const;
+    bool inCircle(int iA, int iB, int iC, int iD) const;
+
+    // Topological operators
+    int makeEdge(int iOrigin, int iDestination, FreeList& freeList);
+    void splice(int iA, int iB);
+    int connect(int iA, int iB, FreeList& freeList);
+    void deleteEdge(int iEdge, FreeList& freeList);
+
+    // Function to chain the free list of a block of quad-edges
+    void initFreeList(int iFirst, int iLast, FreeList& freeList);
+
+    // Function to append one free list to another
+    void joinFreeLists(FreeList& freeList, const FreeList& other);
+
+    // Function to triangulate the sites in [iLo, iHi) using up to iThreadCount threads
+    HullEdges build(int iLo, int iHi, FreeList& freeList, int iThreadCount);
+
+    // Function to merge two adjacent triangulations along the seam between them
+    HullEdges merge(HullEdges left, HullEdges right, FreeList& freeList);
+
+    // Function to sort the sites in [iLo, iHi) using up to iThreadCount threads
+    void sortSites(int iLo, int iHi, int iThreadCount);
+
+    // Function to convert the subdivision to counter-clockwise triangles with encoded neighbour corners
+    std::vector<Triangle> toTriangles(int iThreadCount) const;
+
+    // Constructor to prepare the triangulation of a subset of points
+    DivideAndConquer(const std::vector<Point>& vecPt, const std::vector<int>& vecPointIndices);
+
+public:
+    // Function to triangulate the points with the given indices (iThreadCount = 0 uses every hardware thread).
+    // Triangles refer to the points by their index in vecPt; duplicate points are left out.
+    static std::vector<Triangle> triangulate(const std::vector<Point>& vecPt, const std::vector<int>& vecPointIndices, int iThreadCount = 0,
+                                             const MeshCounters* pCounters = nullptr);
+
+};
+
+#endif // DIVIDEANDCONQUER_H
@@ -0,0 +1,85 @@
+#include "gridindex.h"
+#include <algorithm>
+
+// Default constructor: creates an empty grid
+GridIndex::GridIndex() {}
+
+// Resets the grid over a bounding box with the given resolution
+void GridIndex::reset(float fMinX, float fMinY, float fMaxX, float fMaxY, int iCellsX, int iCellsY)
+{
+    this->fMinX = fMinX;
+    this->fMinY = fMinY;
+    this->iCellsX = std::max(iCellsX, 1);
+    this->iCellsY = std::max(iCellsY, 1);
+
+    // Guard against a degenerate bounding box
+    double dWidth = fMaxX - fMinX;
+    double dHeight = fMaxY - fMinY;
+    dInvCellWidth = dWidth > 0 ? this->iCellsX / dWidth : 0.0;
+    dInvCellHeight = dHeight > 0 ? this->iCellsY / dHeight : 0.0;
+
+    vecCellTriangles.assign(static_cast<size_t>(this->iCellsX) * this->iCellsY, -1);
+}
+
+// Removes all cells from the grid
+void GridIndex::clear()
+{
+    iCellsX = 0;
+    iCellsY = 0;
+    vecCellTriangles.clear();
+}
+
+// Checks whether the grid has any cells
+bool GridIndex::isEmpty() const
+{
+    return vecCellTriangles.empty();
+}
+
+// Getter for the number of cells along the x axis
+int GridIndex::getCellsX() const
+{
+    return iCellsX;
+}
+
+// Getter for the number of cells along the y axis
+int GridIndex::getCellsY() const
+{
+    return iCellsY;
+}
+
+// Finds the cell containing a point, clamping points outside of the grid to the border cells
+int GridIndex::findCell(const Point& pt) const
+{
+    int iCellX = static_cast<int>((pt.getX() - fMinX) * dInvCellWidth);
+    int iCellY = static_cast<int>((pt.getY() - fMinY) * dInvCellHeight);
+
+    iCellX = std::min(std::max(iCellX, 0), iCellsX - 1);
+    iCellY = std::min(std::max(iCellY, 0), iCellsY - 1);
+
+    return iCellY * iCellsX + iCellX;
+}
+
+// Gets the representative triangle of the cell containing a point
+int GridIndex::getTriangle(const Point& pt) const
+{
+    if (isEmpty())
+    {
+        return -1;
+    }
+
+    return vecCellTriangles[findCell(pt)];
+}
+
+// Records a triangle as the representative of the cell containing its centroid
+void GridIndex::update(const Triangle& tri)
+{
+    if (isEmpty())
+    {
+        return;
+    }
+
+    Point ptCentroid((tri.getPoint(0).getX() + tri.getPoint(1).getX() + tri.getPoint(2).getX()) / 3.0f,
+                     (tri.getPoint(0).getY() + tri.getPoint(1).getY() + tri.getPoint(2).getY()) / 3.0f);
+
+    vecCellTriangles[findCell(ptCentroid)] = tri.getIndex();
+}
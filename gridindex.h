@@ -0,0 +1,46 @@
+#ifndef GRIDINDEX_H
+#define GRIDINDEX_H
+
+#include "point.h"
+#include "triangle.h"
+#include <vector>
+
+// Class representing a uniform bucket grid that maps each cell to a representative triangle,
+// used to seed point location walks close to the query point
+class GridIndex {
+
+private:
+    float fMinX{0.0f}, fMinY{0.0f};  // Lower left corner of the indexed area
+    double dInvCellWidth{0.0}, dInvCellHeight{0.0};  // Inverse of the cell dimensions
+    int iCellsX{0}, iCellsY{0};  // Number of cells along each axis
+    std::vector<int> vecCellTriangles;  // Representative triangle index of each cell (-1 when empty)
+
+public:
+    // Default constructor: creates an empty grid
+    GridIndex();
+
+    // Function to reset the grid over a bounding box with the given resolution
+    void reset(float fMinX, float fMinY, float fMaxX, float fMaxY, int iCellsX, int iCellsY);
+
+    // Function to remove all cells from the grid
+    void clear();
+
+    // Function to check whether the grid has any cells
+    bool isEmpty() const;
+
+    // Getters for the grid resolution
+    int getCellsX() const;
+    int getCellsY() const;
+
+    // Function to find the cell containing a point (points outside are clamped to the border cells)
+    int findCell(const Point& pt) const;
+
+    // Function to get the representative triangle of the cell containing a point (-1 if none)
+    int getTriangle(const Point& pt) const;
+
+    // Function to record a triangle as the representative of the cell containing its centroid
+    void update(const Triangle& tri);
+
+};
+
+#endif // GRIDINDEX_H
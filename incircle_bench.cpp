@@ -0,0 +1,100 @@
+#include "predicates.h"
+#include "incirclebatch.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+
+// Micro-benchmark of the incircle test: one query point against batches of triangles.
+// Usage: incircle_bench [triangle count] [batch size] [repetitions]
+int main(int argc, char* argv[])
+{
+    const int iTriangleCount = argc > 1 ? std::atoi(argv[1]) : 4096;
+    const int iBatchSize = argc > 2 ? std::atoi(argv[2]) : 8;
+    const int iRepetitions = argc > 3 ? std::atoi(argv[3]) : 2000;
+
+    // Random counter-clockwise triangles in the unit square, with float coordinates like the mesh points
+    std::mt19937 gen(12345);
+    std::uniform_real_distribution<float> dis(0.0f, 1.0f);
+
+    std::vector<double> vecAx(iTriangleCount), vecAy(iTriangleCount), vecBx(iTriangleCount), vecBy(iTriangleCount), vecCx(iTriangleCount), vecCy(iTriangleCount);
+    for (int k = 0; k < iTriangleCount; ++k)
+    {
+        vecAx[k] = dis(gen); vecAy[k] = dis(gen);
+        vecBx[k] = dis(gen); vecBy[k] = dis(gen);
+        vecCx[k] = dis(gen); vecCy[k] = dis(gen);
+        if (orient2d(vecAx[k], vecAy[k], vecBx[k], vecBy[k], vecCx[k], vecCy[k]) < 0)
+        {
+            std::swap(vecBx[k], vecCx[k]);
+            std::swap(vecBy[k], vecCy[k]);
+        }
+    }
+
+    std::vector<double> vecQueryX(iRepetitions), vecQueryY(iRepetitions);
+    for (int r = 0; r < iRepetitions; ++r)
+    {
+        vecQueryX[r] = dis(gen);
+        vecQueryY[r] = dis(gen);
+    }
+
+    const double dTests = static_cast<double>(iTriangleCount) * iRepetitions;
+    std::vector<double> vecReference(iTriangleCount), vecResult(iTriangleCount);
+
+    // One incircle() call per triangle
+    long long lInside = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < iRepetitions; ++r)
+    {
+        for (int k = 0; k < iTriangleCount; ++k)
+        {
+            vecReference[k] = incircle(vecAx[k], vecAy[k], vecBx[k], vecBy[k], vecCx[k], vecCy[k], vecQueryX[r], vecQueryY[r]);
+            lInside += vecReference[k] > 0;
+        }
+    }
+    double dScalarSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "triangles " << iTriangleCount << ", batch " << iBatchSize << ", repetitions " << iRepetitions
+              << ", supported " << getSimdLevelName(getSupportedSimdLevel()) << std::endl;
+    std::cout << "incircle: " << dTests / dScalarSeconds / 1e6 << " Mtests/s (inside " << lInside << ")" << std::endl;
+
+    // The batched kernel on each instruction set the CPU supports
+    for (SimdLevel eLevel : { SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2 })
+    {
+        if (static_cast<int>(eLevel) > static_cast<int>(getSupportedSimdLevel()))
+        {
+            continue;
+        }
+        setIncircleBatchLevel(eLevel);
+
+        long long lBatchInside = 0;
+        int iMismatches = 0;
+        start = std::chrono::steady_clock::now();
+        for (int r = 0; r < iRepetitions; ++r)
+        {
+            for (int k = 0; k < iTriangleCount; k += iBatchSize)
+            {
+                int iCount = std::min(iBatchSize, iTriangleCount - k);
+                incircleBatch(&vecAx[k], &vecAy[k], &vecBx[k], &vecBy[k], &vecCx[k], &vecCy[k], iCount, vecQueryX[r], vecQueryY[r], &vecResult[k]);
+            }
+            for (int k = 0; k < iTriangleCount; ++k)
+            {
+                lBatchInside += vecResult[k] > 0;
+            }
+        }
+        double dSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        // Check the signs of the last repetition against incircle()
+        for (int k = 0; k < iTriangleCount; ++k)
+        {
+            iMismatches += (vecResult[k] > 0) != (vecReference[k] > 0) || (vecResult[k] < 0) != (vecReference[k] < 0);
+        }
+
+        std::cout << "batch " << getSimdLevelName(eLevel) << ": " << dTests / dSeconds / 1e6
+                  << " Mtests/s, x" << dScalarSeconds / dSeconds << " (inside " << lBatchInside << ", sign mismatches " << iMismatches << ")" << std::endl;
+    }
+
+    return 0;
+}
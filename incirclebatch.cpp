@@ -0,0 +1,203 @@
+#include "incirclebatch.h"
+#include "predicates.h"
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define INCIRCLE_BATCH_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(INCIRCLE_BATCH_SSE2) && defined(__GNUC__)
+#define INCIRCLE_BATCH_AVX2 1
+#include <immintrin.h>
+#endif
+
+// Relative error bound of the double precision incircle determinant (same bound as incircle())
+static const double INCIRCLE_ERROR_BOUND = (10.0 + 96.0 * std::ldexp(1.0, -53)) * std::ldexp(1.0, -53);
+
+// Instruction set used by incircleBatch, detected on first use
+static SimdLevel& selectedLevel()
+{
+    static SimdLevel eLevel = getSupportedSimdLevel();
+    return eLevel;
+}
+
+// Returns the best instruction set supported by the CPU
+SimdLevel getSupportedSimdLevel()
+{
+#if defined(INCIRCLE_BATCH_AVX2)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return SimdLevel::AVX2;
+    }
+#endif
+#if defined(INCIRCLE_BATCH_SSE2)
+    return SimdLevel::SSE2;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+// Returns the instruction set used by incircleBatch
+SimdLevel getIncircleBatchLevel()
+{
+    return selectedLevel();
+}
+
+// Sets the instruction set used by incircleBatch, clamped to what the CPU supports
+void setIncircleBatchLevel(SimdLevel eLevel)
+{
+    SimdLevel eSupported = getSupportedSimdLevel();
+    selectedLevel() = static_cast<int>(eLevel) <= static_cast<int>(eSupported) ? eLevel : eSupported;
+}
+
+// Returns the name of an instruction set
+const char* getSimdLevelName(SimdLevel eLevel)
+{
+    switch (eLevel)
+    {
+    case SimdLevel::SSE2: return "sse2";
+    case SimdLevel::AVX2: return "avx2";
+    default: return "scalar";
+    }
+}
+
+// Tests lanes [iBegin, iEnd) one at a time
+static void incircleBatchScalar(const double* pdAx, const double* pdAy, const double* pdBx, const double* pdBy,
+                                const double* pdCx, const double* pdCy, int iBegin, int iEnd, double dDx, double dDy, double* pdResult)
+{
+    for (int k = iBegin; k < iEnd; ++k)
+    {
+        pdResult[k] = incircle(pdAx[k], pdAy[k], pdBx[k], pdBy[k], pdCx[k], pdCy[k], dDx, dDy);
+    }
+}
+
+#if defined(INCIRCLE_BATCH_SSE2)
+// Tests two lanes per step with SSE2 and returns the number of lanes processed
+static int incircleBatchSSE2(const double* pdAx, const double* pdAy, const double* pdBx, const double* pdBy,
+                             const double* pdCx, const double* pdCy, int iCount, double dDx, double dDy, double* pdResult)
+{
+    const __m128d vDx = _mm_set1_pd(dDx), vDy = _mm_set1_pd(dDy);
+    const __m128d vBound = _mm_set1_pd(INCIRCLE_ERROR_BOUND);
+    const __m128d vAbsMask = _mm_castsi128_pd(_mm_set1_epi64x(0x7fffffffffffffffLL));
+
+    int k = 0;
+    for (; k + 2 <= iCount; k += 2)
+    {
+        __m128d vAdx = _mm_sub_pd(_mm_loadu_pd(pdAx + k), vDx), vAdy = _mm_sub_pd(_mm_loadu_pd(pdAy + k), vDy);
+        __m128d vBdx = _mm_sub_pd(_mm_loadu_pd(pdBx + k), vDx), vBdy = _mm_sub_pd(_mm_loadu_pd(pdBy + k), vDy);
+        __m128d vCdx = _mm_sub_pd(_mm_loadu_pd(pdCx + k), vDx), vCdy = _mm_sub_pd(_mm_loadu_pd(pdCy + k), vDy);
+
+        __m128d vBdxCdy = _mm_mul_pd(vBdx, vCdy), vCdxBdy = _mm_mul_pd(vCdx, vBdy);
+        __m128d vALift = _mm_add_pd(_mm_mul_pd(vAdx, vAdx), _mm_mul_pd(vAdy, vAdy));
+        __m128d vCdxAdy = _mm_mul_pd(vCdx, vAdy), vAdxCdy = _mm_mul_pd(vAdx, vCdy);
+        __m128d vBLift = _mm_add_pd(_mm_mul_pd(vBdx, vBdx), _mm_mul_pd(vBdy, vBdy));
+        __m128d vAdxBdy = _mm_mul_pd(vAdx, vBdy), vBdxAdy = _mm_mul_pd(vBdx, vAdy);
+        __m128d vCLift = _mm_add_pd(_mm_mul_pd(vCdx, vCdx), _mm_mul_pd(vCdy, vCdy));
+
+        __m128d vDet = _mm_add_pd(_mm_add_pd(_mm_mul_pd(vALift, _mm_sub_pd(vBdxCdy, vCdxBdy)),
+                                             _mm_mul_pd(vBLift, _mm_sub_pd(vCdxAdy, vAdxCdy))),
+                                  _mm_mul_pd(vCLift, _mm_sub_pd(vAdxBdy, vBdxAdy)));
+
+        __m128d vPermanent = _mm_add_pd(_mm_add_pd(
+            _mm_mul_pd(_mm_add_pd(_mm_and_pd(vBdxCdy, vAbsMask), _mm_and_pd(vCdxBdy, vAbsMask)), vALift),
+            _mm_mul_pd(_mm_add_pd(_mm_and_pd(vCdxAdy, vAbsMask), _mm_and_pd(vAdxCdy, vAbsMask)), vBLift)),
+            _mm_mul_pd(_mm_add_pd(_mm_and_pd(vAdxBdy, vAbsMask), _mm_and_pd(vBdxAdy, vAbsMask)), vCLift));
+
+        _mm_storeu_pd(pdResult + k, vDet);
+
+        // Lanes whose determinant does not clear the error bound take the exact path
+        __m128d vCertain = _mm_cmpgt_pd(_mm_and_pd(vDet, vAbsMask), _mm_mul_pd(vBound, vPermanent));
+        int iMask = _mm_movemask_pd(vCertain);
+        if (iMask != 0x3)
+        {
+            for (int j = 0; j < 2; ++j)
+            {
+                if (!(iMask & (1 << j)))
+                {
+                    pdResult[k + j] = incircleExact(pdAx[k + j], pdAy[k + j], pdBx[k + j], pdBy[k + j], pdCx[k + j], pdCy[k + j], dDx, dDy);
+                }
+            }
+        }
+    }
+    return k;
+}
+#endif
+
+#if defined(INCIRCLE_BATCH_AVX2)
+// Tests four lanes per step with AVX2 and returns the number of lanes processed
+__attribute__((target("avx2")))
+static int incircleBatchAVX2(const double* pdAx, const double* pdAy, const double* pdBx, const double* pdBy,
+                             const double* pdCx, const double* pdCy, int iCount, double dDx, double dDy, double* pdResult)
+{
+    const __m256d vDx = _mm256_set1_pd(dDx), vDy = _mm256_set1_pd(dDy);
+    const __m256d vBound = _mm256_set1_pd(INCIRCLE_ERROR_BOUND);
+    const __m256d vAbsMask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7fffffffffffffffLL));
+
+    int k = 0;
+    for (; k + 4 <= iCount; k += 4)
+    {
+        __m256d vAdx = _mm256_sub_pd(_mm256_loadu_pd(pdAx + k), vDx), vAdy = _mm256_sub_pd(_mm256_loadu_pd(pdAy + k), vDy);
+        __m256d vBdx = _mm256_sub_pd(_mm256_loadu_pd(pdBx + k), vDx), vBdy = _mm256_sub_pd(_mm256_loadu_pd(pdBy + k), vDy);
+        __m256d vCdx = _mm256_sub_pd(_mm256_loadu_pd(pdCx + k), vDx), vCdy = _mm256_sub_pd(_mm256_loadu_pd(pdCy + k), vDy);
+
+        __m256d vBdxCdy = _mm256_mul_pd(vBdx, vCdy), vCdxBdy = _mm256_mul_pd(vCdx, vBdy);
+        __m256d vALift = _mm256_add_pd(_mm256_mul_pd(vAdx, vAdx), _mm256_mul_pd(vAdy, vAdy));
+        __m256d vCdxAdy = _mm256_mul_pd(vCdx, vAdy), vAdxCdy = _mm256_mul_pd(vAdx, vCdy);
+        __m256d vBLift = _mm256_add_pd(_mm256_mul_pd(vBdx, vBdx), _mm256_mul_pd(vBdy, vBdy));
+        __m256d vAdxBdy = _mm256_mul_pd(vAdx, vBdy), vBdxAdy = _mm256_mul_pd(vBdx, vAdy);
+        __m256d vCLift = _mm256_add_pd(_mm256_mul_pd(vCdx, vCdx), _mm256_mul_pd(vCdy, vCdy));
+
+        __m256d vDet = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(vALift, _mm256_sub_pd(vBdxCdy, vCdxBdy)),
+                                                   _mm256_mul_pd(vBLift, _mm256_sub_pd(vCdxAdy, vAdxCdy))),
+                                     _mm256_mul_pd(vCLift, _mm256_sub_pd(vAdxBdy, vBdxAdy)));
+
+        __m256d vPermanent = _mm256_add_pd(_mm256_add_pd(
+            _mm256_mul_pd(_mm256_add_pd(_mm256_and_pd(vBdxCdy, vAbsMask), _mm256_and_pd(vCdxBdy, vAbsMask)), vALift),
+            _mm256_mul_pd(_mm256_add_pd(_mm256_and_pd(vCdxAdy, vAbsMask), _mm256_and_pd(vAdxCdy, vAbsMask)), vBLift)),
+            _mm256_mul_pd(_mm256_add_pd(_mm256_and_pd(vAdxBdy, vAbsMask), _mm256_and_pd(vBdxAdy, vAbsMask)), vCLift));
+
+        _mm256_storeu_pd(pdResult + k, vDet);
+
+        // Lanes whose determinant does not clear the error bound take the exact path
+        __m256d vCertain = _mm256_cmp_pd(_mm256_and_pd(vDet, vAbsMask), _mm256_mul_pd(vBound, vPermanent), _CMP_GT_OQ);
+        int iMask = _mm256_movemask_pd(vCertain);
+        if (iMask != 0xf)
+        {
+            for (int j = 0; j < 4; ++j)
+            {
+                if (!(iMask & (1 << j)))
+                {
+                    pdResult[k + j] = incircleExact(pdAx[k + j], pdAy[k + j], pdBx[k + j], pdBy[k + j], pdCx[k + j], pdCy[k + j], dDx, dDy);
+                }
+            }
+        }
+    }
+    return k;
+}
+#endif
+
+// Tests D against several circles with the selected instruction set; the lanes left over are tested one at a time
+void incircleBatch(const double* pdAx, const double* pdAy, const double* pdBx, const double* pdBy,
+                   const double* pdCx, const double* pdCy, int iCount, double dDx, double dDy, double* pdResult)
+{
+    const SimdLevel eLevel = selectedLevel();
+    int iDone = 0;
+
+#if defined(INCIRCLE_BATCH_AVX2)
+    if (eLevel == SimdLevel::AVX2)
+    {
+        iDone = incircleBatchAVX2(pdAx, pdAy, pdBx, pdBy, pdCx, pdCy, iCount, dDx, dDy, pdResult);
+    }
+#endif
+#if defined(INCIRCLE_BATCH_SSE2)
+    if (eLevel != SimdLevel::Scalar)
+    {
+        iDone += incircleBatchSSE2(pdAx + iDone, pdAy + iDone, pdBx + iDone, pdBy + iDone, pdCx + iDone, pdCy + iDone,
+                                   iCount - iDone, dDx, dDy, pdResult + iDone);
+    }
+#endif
+
+    incircleBatchScalar(pdAx, pdAy, pdBx, pdBy, pdCx, pdCy, iDone, iCount, dDx, dDy, pdResult);
+}
@@ -0,0 +1,31 @@
+#ifndef INCIRCLEBATCH_H
+#define INCIRCLEBATCH_H
+
+// Batched incircle test: one query point against the circumcircles of several triangles at once.
+// The determinants are evaluated 2 (SSE2) or 4 (AVX2) lanes at a time with the same forward error filter
+// as incircle(); lanes whose sign is uncertain are recomputed with the exact expansion arithmetic, so
+// every result has the correct sign. The instruction set is picked at runtime from what the CPU supports.
+
+// Instruction sets the batched incircle test can run on
+enum class SimdLevel {
+    Scalar,  // Plain double precision code
+    SSE2,  // Two lanes per instruction
+    AVX2  // Four lanes per instruction
+};
+
+// Function to get the best instruction set supported by the CPU
+SimdLevel getSupportedSimdLevel();
+
+// Getter and setter for the instruction set used by incircleBatch (the setter clamps to what the CPU supports)
+SimdLevel getIncircleBatchLevel();
+void setIncircleBatchLevel(SimdLevel eLevel);
+
+// Function to get the name of an instruction set
+const char* getSimdLevelName(SimdLevel eLevel);
+
+// Function to test D against the circles through (A[k], B[k], C[k]) for k < iCount
+// (pdResult[k] is positive if D is inside when the triangle is counter-clockwise, negative if outside, zero if cocircular)
+void incircleBatch(const double* pdAx, const double* pdAy, const double* pdBx, const double* pdBy,
+                   const double* pdCx, const double* pdCy, int iCount, double dDx, double dDy, double* pdResult);
+
+#endif // INCIRCLEBATCH_H
@@ -0,0 +1,151 @@
+#include "mesh.h"
+#include "predicates.h"
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <vector>
+
+static const int BUILD_POINTS = 20000;  // Points triangulated before the batches
+static const int BATCH_COUNT = 6;  // Batches inserted into each mesh, every other one reaching outside of the hull
+static const int BATCH_POINTS = 1000;  // Points per batch
+
+// Counts the defects of a mesh: slots whose index is wrong, corners that do not match the points, neighbour
+// corners that are not symmetric and edges whose opposite point lies inside the circumcircle
+static int countDefects(const Mesh& mesh)
+{
+    const Span<const Point> spanPoints = mesh.getShapeView();
+    const Span<const Triangle> spanTriangles = mesh.getTriView();
+    int iDefects = 0;
+    for (size_t i = 0; i < spanTriangles.size(); ++i)
+    {
+        const Triangle& triangle = spanTriangles[i];
+        if (triangle.getIndex() != static_cast<int>(i))
+        {
+            ++iDefects;
+        }
+        if (triangle.isFree())
+        {
+            continue;
+        }
+
+        for (int j = 0; j < 3; ++j)
+        {
+            const Point& ptCorner = spanPoints[triangle.getPointIndex(j)];
+            if (ptCorner.getX() != triangle.getPoint(j).getX() || ptCorner.getY() != triangle.getPoint(j).getY())
+            {
+                ++iDefects;
+            }
+
+            const int iCorner = triangle.getNeighbourCorner(j);
+            if (iCorner < 0)
+            {
+                continue;
+            }
+            const Triangle& neighbour = spanTriangles[iCorner / 3];
+            if (neighbour.isFree() || neighbour.getNeighbourCorner(iCorner % 3) != static_cast<int>(3 * i + j))
+            {
+                ++iDefects;
+                continue;
+            }
+
+            const Point& ptOpposite = spanPoints[neighbour.getPointIndex((iCorner % 3 + 2) % 3)];
+            if (incircle(triangle.getPoint(0), triangle.getPoint(1), triangle.getPoint(2), ptOpposite) > 0)
+            {
+                ++iDefects;
+            }
+        }
+    }
+    return iDefects;
+}
+
+// Counts the slots created or rewritten since the snapshot that are missing from the sorted changed list
+static int countUnreported(const Mesh& mesh, const std::vector<Triangle>& vecBefore, const std::vector<int>& vecChanged)
+{
+    const Span<const Triangle> spanTriangles = mesh.getTriView();
+    int iUnreported = 0;
+    for (size_t i = 0; i < spanTriangles.size(); ++i)
+    {
+        bool bChanged = i >= vecBefore.size();
+        for (int j = 0; j < 3 && !bChanged; ++j)
+        {
+            bChanged = spanTriangles[i].getPointIndex(j) != vecBefore[i].getPointIndex(j)
+                       || spanTriangles[i].getNeighbourCorner(j) != vecBefore[i].getNeighbourCorner(j);
+        }
+        if (bChanged && !std::binary_search(vecChanged.begin(), vecChanged.end(), static_cast<int>(i)))
+        {
+            ++iUnreported;
+        }
+    }
+    return iUnreported;
+}
+
+// Builds a mesh, keeps its super triangle and inserts batches into it, checking after each batch that every point was
+// inserted, that the result lists each slot created, reshaped or relinked once, and that the mesh is still Delaunay
+static int testInsertPoints(InsertionEngine eEngine, bool bGrid)
+{
+    std::mt19937 gen(4);
+    std::uniform_real_distribution<float> disInside(0.0f, 1000.0f);
+    std::uniform_real_distribution<float> disAround(-300.0f, 1300.0f);
+    std::vector<Point> vecPt;
+    for (int i = 0; i < BUILD_POINTS; ++i)
+    {
+        vecPt.emplace_back(disInside(gen), disInside(gen));
+    }
+
+    Mesh mesh(vecPt);
+    mesh.setInsertionEngine(eEngine);
+    mesh.setTriVector({ mesh.superTriangle() });
+    mesh.buildMesh();
+    if (bGrid)
+    {
+        mesh.enableGridIndex();
+    }
+
+    int iFailures = 0;
+    for (int iBatch = 0; iBatch < BATCH_COUNT; ++iBatch)
+    {
+        // The odd batches spread past the box of the built points, which stays well inside the super triangle
+        std::vector<Point> vecBatch;
+        for (int i = 0; i < BATCH_POINTS; ++i)
+        {
+            vecBatch.push_back(iBatch % 2 ? Point(disAround(gen), disAround(gen)) : Point(disInside(gen), disInside(gen)));
+        }
+
+        const std::vector<Triangle> vecBefore(mesh.getTriView().begin(), mesh.getTriView().end());
+        const size_t uPointsBefore = mesh.getShapeView().size();
+        const std::vector<int> vecChanged = mesh.insertPoints(vecBatch);
+
+        const bool bSorted = std::adjacent_find(vecChanged.begin(), vecChanged.end(), std::greater_equal<int>()) == vecChanged.end();
+        const bool bInRange = vecChanged.empty() || (vecChanged.front() >= 0 && vecChanged.back() < static_cast<int>(mesh.getTriView().size()));
+        const size_t uInserted = mesh.getShapeView().size() - uPointsBefore;
+        const int iUnreported = bSorted && bInRange ? countUnreported(mesh, vecBefore, vecChanged) : -1;
+        const int iDefects = countDefects(mesh);
+
+        if (!bSorted || !bInRange || uInserted != BATCH_POINTS || iUnreported != 0 || iDefects != 0)
+        {
+            std::cerr << (eEngine == InsertionEngine::BowyerWatson ? "BowyerWatson" : "SplitAndFlip") << (bGrid ? ", grid" : ", no grid")
+                      << ", batch " << iBatch << ": " << uInserted << " points inserted, " << vecChanged.size() << " slots reported"
+                      << (bSorted && bInRange ? "" : " (not sorted, unique and in range)") << ", " << iUnreported << " unreported, "
+                      << iDefects << " defects" << std::endl;
+            ++iFailures;
+        }
+    }
+    return iFailures;
+}
+
+// Checks the slots reported by Mesh::insertPoints and the validity of the mesh after batches inside and around the hull
+int main()
+{
+    int iFailures = 0;
+    for (InsertionEngine eEngine : { InsertionEngine::SplitAndFlip, InsertionEngine::BowyerWatson })
+    {
+        for (bool bGrid : { false, true })
+        {
+            iFailures += testInsertPoints(eEngine, bGrid);
+        }
+    }
+
+    std::cout << (iFailures == 0 ? "insertPoints checks passed" : "insertPoints checks failed") << std::endl;
+    return iFailures == 0 ? 0 : 1;
+}
@@ -0,0 +1,111 @@
+#include "pointloader.h"
+#include "mesh.h"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Throughput of the point loaders on generated files: the mapped binary file and the parallel text parser.
+// The files are written once and read back from the page cache, so the figures are an upper bound for cold reads.
+// Usage: loader_bench [point count] [maximum thread count] [file prefix]
+int main(int argc, char* argv[])
+{
+    const long long lPointCount = argc > 1 ? std::atoll(argv[1]) : 50000000;
+    const int iMaxThreads = argc > 2 ? std::atoi(argv[2]) : std::max(1u, std::thread::hardware_concurrency());
+    const std::string sPrefix = argc > 3 ? argv[3] : "loader_bench";
+    const std::string sBinaryPath = sPrefix + ".bin", sTextPath = sPrefix + ".xyz";
+
+    // Generate the points and write both files
+    std::mt19937 gen(12345);
+    std::uniform_real_distribution<float> dis(0.0f, 100000.0f);
+    std::vector<Point> vecPt;
+    vecPt.reserve(lPointCount);
+    for (long long i = 0; i < lPointCount; ++i)
+    {
+        vecPt.emplace_back(dis(gen), dis(gen));
+    }
+
+    if (!writePointBinary(sBinaryPath, vecPt))
+    {
+        return 1;
+    }
+
+    {
+        std::ofstream text(sTextPath, std::ios::binary);
+        char acLine[64];
+        for (const Point& pt : vecPt)
+        {
+            char* p = std::to_chars(acLine, acLine + 30, pt.getX()).ptr;
+            *p++ = ' ';
+            p = std::to_chars(p, p + 30, pt.getY()).ptr;
+            *p++ = '\n';
+            text.write(acLine, p - acLine);
+        }
+    }
+
+    const double dBinaryGB = lPointCount * sizeof(Point) / 1e9;
+    std::cout << "points " << lPointCount << ", binary " << dBinaryGB << " GB, hardware threads " << std::thread::hardware_concurrency() << std::endl;
+
+    // Binary: map the file and touch every point, then hand the points to a mesh
+    auto start = std::chrono::steady_clock::now();
+    PointFile file;
+    if (!file.open(sBinaryPath))
+    {
+        return 1;
+    }
+    double dSum = 0.0;
+    for (const Point& pt : file)
+    {
+        dSum += pt.getX() + pt.getY();
+    }
+    double dSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "binary map + read: " << dSeconds << " s, " << dBinaryGB / dSeconds << " GB/s (checksum " << dSum << ")" << std::endl;
+
+    start = std::chrono::steady_clock::now();
+    Mesh mesh(std::vector<Point>{});
+    mesh.setShape(file.begin(), file.end());
+    dSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "binary Mesh::setShape: " << dSeconds << " s, " << dBinaryGB / dSeconds << " GB/s" << std::endl;
+    file.close();
+
+    // Text: parse with 1 to N threads
+    MappedFile text(sTextPath);
+    const double dTextGB = text.size() / 1e9;
+    std::cout << "text " << dTextGB << " GB" << std::endl;
+    std::cout << "threads\tseconds\tGB/s\tMpoints/s" << std::endl;
+
+    std::vector<int> vecThreadCounts;
+    for (int iThreads = 1; iThreads < iMaxThreads; iThreads *= 2)
+    {
+        vecThreadCounts.push_back(iThreads);
+    }
+    vecThreadCounts.push_back(iMaxThreads);
+
+    for (int iThreads : vecThreadCounts)
+    {
+        start = std::chrono::steady_clock::now();
+        std::vector<Point> vecParsed = parsePointText(text.data(), text.data() + text.size(), iThreads);
+        dSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        if (vecParsed.size() != vecPt.size() || !std::equal(vecParsed.begin(), vecParsed.end(), vecPt.begin(), [](const Point& a, const Point& b) {
+                return a.getX() == b.getX() && a.getY() == b.getY();
+            }))
+        {
+            std::cerr << "parsed points differ from the generated points" << std::endl;
+            return 1;
+        }
+
+        std::cout << iThreads << "\t" << dSeconds << "\t" << dTextGB / dSeconds << "\t" << vecParsed.size() / dSeconds / 1e6 << std::endl;
+    }
+
+    std::remove(sBinaryPath.c_str());
+    std::remove(sTextPath.c_str());
+    return 0;
+}
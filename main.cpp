@@ -1,7 +1,10 @@
 #include "point.h"
 #include "triangle.h"
 #include "mesh.h"
+#include "pointloader.h"
 #include <iostream>
+#include <string>
+#include <utility>
 #include <vector>
 #include <QApplication>
 #include <QGraphicsScene>
@@ -24,12 +27,35 @@ int main(int argc, char *argv[])
 
     // Mesh Workflow
     Mesh k(testCaseRect);
+
+    // Points given on the command line replace the test case: a raw float32 x/y file (.bin) or CSV / XYZ text
+    if (argc > 1)
+    {
+        std::string sPath = argv[1];
+        if (sPath.size() > 4 && sPath.compare(sPath.size() - 4, 4, ".bin") == 0)
+        {
+            PointFile file;
+            if (file.open(sPath))
+            {
+                k.setShape(file.begin(), file.end());
+            }
+        }
+        else
+        {
+            std::vector<Point> vecPt;
+            if (loadPointText(sPath, vecPt))
+            {
+                k.setShape(std::move(vecPt));
+            }
+        }
+    }
+
     k.setTriVector({ k.superTriangle() });
     k.buildMesh();
     k.removeHelperTriangles();
     k.equilateralizeTriangles();
 
-    std::vector<Triangle> meshTriangles = k.getTriVector();
+    Span<const Triangle> meshTriangles = k.getTriView();
 
     // Prints the mesh and each triangles' neighbours
     for (int i = 0; i < meshTriangles.size(); ++i)
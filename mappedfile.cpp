@@ -0,0 +1,156 @@
+#include "mappedfile.h"
+#include <iostream>
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Creates an object that maps nothing
+MappedFile::MappedFile()
+{
+}
+
+// Maps a file
+MappedFile::MappedFile(const std::string& sPath)
+{
+    open(sPath);
+}
+
+// Unmaps the file
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+// Takes over the mapping of another object
+MappedFile::MappedFile(MappedFile&& other) noexcept
+{
+    *this = std::move(other);
+}
+
+// Replaces the mapping with the one of another object
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other)
+    {
+        close();
+        std::swap(pData, other.pData);
+        std::swap(uSize, other.uSize);
+#ifdef _WIN32
+        std::swap(hFile, other.hFile);
+        std::swap(hMapping, other.hMapping);
+#endif
+    }
+    return *this;
+}
+
+// Maps a file read-only. An empty file is open but has no data.
+bool MappedFile::open(const std::string& sPath)
+{
+    close();
+
+#ifdef _WIN32
+    HANDLE hOpened = CreateFileA(sPath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    LARGE_INTEGER size;
+    if (hOpened == INVALID_HANDLE_VALUE || !GetFileSizeEx(hOpened, &size))
+    {
+        if (hOpened != INVALID_HANDLE_VALUE) CloseHandle(hOpened);
+        std::cerr << "Could not open " << sPath << "." << std::endl;
+        return false;
+    }
+    hFile = hOpened;
+    uSize = static_cast<size_t>(size.QuadPart);
+
+    if (uSize > 0)
+    {
+        hMapping = CreateFileMappingA(hOpened, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        pData = hMapping ? static_cast<const char*>(MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0)) : nullptr;
+        if (!pData)
+        {
+            std::cerr << "Could not map " << sPath << "." << std::endl;
+            close();
+            return false;
+        }
+    }
+#else
+    int iDescriptor = ::open(sPath.c_str(), O_RDONLY);
+    struct stat status;
+    if (iDescriptor < 0 || fstat(iDescriptor, &status) != 0)
+    {
+        if (iDescriptor >= 0) ::close(iDescriptor);
+        std::cerr << "Could not open " << sPath << "." << std::endl;
+        return false;
+    }
+    uSize = static_cast<size_t>(status.st_size);
+
+    if (uSize > 0)
+    {
+        void* pMapping = mmap(nullptr, uSize, PROT_READ, MAP_PRIVATE, iDescriptor, 0);
+        if (pMapping == MAP_FAILED)
+        {
+            ::close(iDescriptor);
+            uSize = 0;
+            std::cerr << "Could not map " << sPath << "." << std::endl;
+            return false;
+        }
+
+        // The file is read front to back
+        madvise(pMapping, uSize, MADV_SEQUENTIAL);
+        pData = static_cast<const char*>(pMapping);
+    }
+
+    // The mapping stays valid after the descriptor is closed
+    ::close(iDescriptor);
+#endif
+
+    if (!pData)
+    {
+        pData = "";  // Empty file: open, without bytes
+    }
+    return true;
+}
+
+// Unmaps the file
+void MappedFile::close()
+{
+#ifdef _WIN32
+    if (pData && uSize > 0) UnmapViewOfFile(pData);
+    if (hMapping) CloseHandle(hMapping);
+    if (hFile) CloseHandle(hFile);
+    hMapping = nullptr;
+    hFile = nullptr;
+#else
+    if (pData && uSize > 0)
+    {
+        munmap(const_cast<char*>(pData), uSize);
+    }
+#endif
+
+    pData = nullptr;
+    uSize = 0;
+}
+
+// Checks whether a file is mapped
+bool MappedFile::isOpen() const
+{
+    return pData != nullptr;
+}
+
+// Returns the first mapped byte
+const char* MappedFile::data() const
+{
+    return pData;
+}
+
+// Returns the size of the mapped file in bytes
+size_t MappedFile::size() const
+{
+    return uSize;
+}
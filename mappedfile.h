@@ -0,0 +1,50 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+
+// Class mapping a whole file read-only into memory, so that it can be read without copying it into a buffer
+class MappedFile {
+
+private:
+    const char* pData{nullptr};  // First byte of the mapping (nullptr if no file is mapped)
+    size_t uSize{0};  // Size of the file in bytes
+
+#ifdef _WIN32
+    void* hFile{nullptr};  // File handle
+    void* hMapping{nullptr};  // File mapping handle
+#endif
+
+public:
+    // Default constructor: maps nothing
+    MappedFile();
+
+    // Constructor to map a file (check isOpen for the result)
+    explicit MappedFile(const std::string& sPath);
+
+    // Destructor: unmaps the file
+    ~MappedFile();
+
+    // A mapping has a single owner
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    // Function to map a file, replacing the current mapping; returns false if the file cannot be mapped
+    bool open(const std::string& sPath);
+
+    // Function to unmap the file
+    void close();
+
+    // Function to check whether a file is mapped
+    bool isOpen() const;
+
+    // Getters for the mapped bytes
+    const char* data() const;
+    size_t size() const;
+
+};
+
+#endif // MAPPEDFILE_H
@@ -1,9 +1,14 @@
 #include "mesh.h"
+#include "spatialsort.h"
+#include "predicates.h"
+#include "incirclebatch.h"
+#include "divideandconquer.h"
+#include "parallel.h"
 #include <iostream>
 #include <random>
 #include <algorithm>
-#include <stack>
-#include <queue>
+#include <cmath>
+#include <utility>
 
 // Constructor: Creates the mesh with a given set of points
 Mesh::Mesh(const std::vector<Point>& vecPt)
@@ -11,6 +16,12 @@ Mesh::Mesh(const std::vector<Point>& vecPt)
     setShape(vecPt);
 }
 
+// Constructor: Creates the mesh with a given set of points, taking over their storage
+Mesh::Mesh(std::vector<Point>&& vecPt)
+{
+    setShape(std::move(vecPt));
+}
+
 // Returns the shape of the mesh as a vector of points
 std::vector<Point> Mesh::getShape() const
 {
@@ -23,6 +34,18 @@ void Mesh::setShape(const std::vector<Point>& vecPt)
     vecPtShape = vecPt;
 }
 
+// Sets the shape of the mesh, taking over the storage of a vector of points
+void Mesh::setShape(std::vector<Point>&& vecPt)
+{
+    vecPtShape = std::move(vecPt);
+}
+
+// Sets the shape of the mesh from a range of points, such as a mapped point file
+void Mesh::setShape(const Point* pBegin, const Point* pEnd)
+{
+    vecPtShape.assign(pBegin, pEnd);
+}
+
 // Returns the triangle vector
 std::vector<Triangle> Mesh::getTriVector() const
 {
@@ -32,109 +55,973 @@ std::vector<Triangle> Mesh::getTriVector() const
 // Sets the triangle vector
 void Mesh::setTriVector(const std::vector<Triangle>& vecTri)
 {
-    vecTriangles = vecTri;
+    vecTriangles = vecTri;
+    resolveNeighbourCorners();
+}
+
+// Sets the triangle vector, taking over its storage
+void Mesh::setTriVector(std::vector<Triangle>&& vecTri)
+{
+    vecTriangles = std::move(vecTri);
+    resolveNeighbourCorners();
+}
+
+// Returns a view of the points
+Span<const Point> Mesh::getShapeView() const
+{
+    return vecPtShape;
+}
+
+// Returns a view of the triangles
+Span<const Triangle> Mesh::getTriView() const
+{
+    return vecTriangles;
+}
+
+// Moves the points and triangles out of the mesh; the mesh is left without points, triangles or build state
+MeshBuffers Mesh::release()
+{
+    MeshBuffers buffers;
+    buffers.vecPoints = std::move(vecPtShape);
+    buffers.vecTriangles = std::move(vecTriangles);
+
+    vecPtShape.clear();
+    vecTriangles.clear();
+    vecInsertionOrder.clear();
+    iSuperPointIndex = -1;
+    gridIndex.clear();
+    vecTriangleMarks.clear();
+    uMarkEpoch = 0;
+    vecFreeTriangleSlots.clear();
+    vecVertexTriangles.clear();
+    bVertexTrianglesComplete = false;
+
+    return buffers;
+}
+
+// Reserves the points and triangles of a mesh of uPointCount points (Euler bound of 2n + 1 triangles)
+void Mesh::reserve(size_t uPointCount)
+{
+    vecPtShape.reserve(uPointCount + 3);
+    vecTriangles.reserve(2 * uPointCount + 1);
+}
+
+// Copies the points and triangles into the compact structure-of-arrays representation
+CompactMesh Mesh::toCompact() const
+{
+    if (vecFreeTriangleSlots.empty())
+    {
+        return CompactMesh(vecPtShape, vecTriangles);
+    }
+
+    // Leave out the free slots and renumber the neighbours of the live triangles
+    std::vector<int> vecRemap(vecTriangles.size(), -1);
+    std::vector<Triangle> vecLive;
+    vecLive.reserve(vecTriangles.size() - vecFreeTriangleSlots.size());
+    for (const Triangle& triangle : vecTriangles)
+    {
+        if (!triangle.isFree())
+        {
+            vecRemap[triangle.getIndex()] = vecLive.size();
+            vecLive.push_back(triangle);
+        }
+    }
+
+    for (Triangle& triangle : vecLive)
+    {
+        triangle.setIndex(vecRemap[triangle.getIndex()]);
+        for (int i = 0; i < 3; ++i)
+        {
+            const int iCorner = triangle.getNeighbourCorner(i);
+            if (iCorner != -1)
+            {
+                triangle.setNeighbourCorner(i, 3 * vecRemap[iCorner / 3] + iCorner % 3);
+            }
+        }
+    }
+
+    return CompactMesh(vecPtShape, vecLive);
+}
+
+// Enables or disables the spatially sorted insertion order
+void Mesh::setSpatialSort(bool bEnable, unsigned int uSeed)
+{
+    bSpatialSort = bEnable;
+    uSortSeed = uSeed;
+}
+
+// Returns whether the spatially sorted insertion order is enabled
+bool Mesh::getSpatialSort() const
+{
+    return bSpatialSort;
+}
+
+// Enables or disables the parallel divide-and-conquer build
+void Mesh::setParallelBuild(bool bEnable, int iThreads)
+{
+    bParallelBuild = bEnable;
+    iThreadCount = iThreads;
+}
+
+// Returns whether buildMesh uses the parallel divide-and-conquer build
+bool Mesh::getParallelBuild() const
+{
+    return bParallelBuild;
+}
+
+// Returns the number of threads used by the parallel build and refinement (0 uses every hardware thread)
+int Mesh::getThreadCount() const
+{
+    return iThreadCount;
+}
+
+// Enables or disables the parallel refinement used by equilateralizeTriangles
+void Mesh::setParallelRefinement(bool bEnable, int iThreads)
+{
+    bParallelRefinement = bEnable;
+    iThreadCount = iThreads;
+}
+
+// Returns whether equilateralizeTriangles refines conflict-free batches in parallel
+bool Mesh::getParallelRefinement() const
+{
+    return bParallelRefinement;
+}
+
+// Returns the insertion order used by the last build
+const std::vector<int>& Mesh::getInsertionOrder() const
+{
+    return vecInsertionOrder;
+}
+
+// Builds the mesh by iterating through all points in vecPtShape.
+void Mesh::buildMesh()
+{
+    ScopedPhase phase(counters, MeshPhase::Build);
+
+    // The super triangle points are appended after the input points and are not inserted
+    int iPointCount = iSuperPointIndex >= 0 ? iSuperPointIndex : static_cast<int>(vecPtShape.size()) - 3;
+    if (iPointCount <= 0) { return; }
+
+    if (bParallelBuild)
+    {
+        buildMeshDivideAndConquer(iPointCount);
+        return;
+    }
+
+    // Determine the insertion order; point indices in the triangles always refer to the original vecPtShape
+    if (bSpatialSort)
+    {
+        vecInsertionOrder = brioOrder(vecPtShape, iPointCount, uSortSeed);
+    }
+    else
+    {
+        vecInsertionOrder.resize(iPointCount);
+        for (int i = 0; i < iPointCount; ++i)
+        {
+            vecInsertionOrder[i] = i;
+        }
+    }
+
+    // Every insertion adds two triangles (2n + 1 in all with the super triangle, by the Euler formula),
+    // so the triangle vector never reallocates during the build
+    vecTriangles.reserve(vecTriangles.size() + 2 * static_cast<size_t>(iPointCount));
+
+    int iPreviousTriIndex = -1;
+
+    for (int iPointIndex : vecInsertionOrder)
+    {
+        // Find the triangle that contains the current point, starting next to the previous insertion
+        int iTriIndex = findContainingTriangle(vecPtShape[iPointIndex], iPreviousTriIndex);
+
+        // Create new triangles from the found triangle and current point
+        insertPoint(iTriIndex, iPointIndex);
+
+        // Consecutive points are only close to each other in the spatially sorted order
+        if (bSpatialSort)
+        {
+            iPreviousTriIndex = iTriIndex;
+        }
+    }
+}
+
+// Inserts a batch of points into the built mesh. The points are appended to vecPtShape (after the super triangle
+// points if they are still there); the batch is inserted in BRIO / Hilbert order so that each point is located by
+// a short walk from the previous insertion, or from the bucket grid when it is enabled. The slots reshaped by the
+// insertions are collected through onTriangleChanged, and the slots around them whose links changed through linkNeighbours.
+std::vector<int> Mesh::insertPoints(Span<const Point> spanPoints)
+{
+    std::vector<int> vecChanged;
+    if (vecTriangles.empty() || spanPoints.empty())
+    {
+        return vecChanged;
+    }
+
+    const std::vector<int> vecOrder = brioOrder(spanPoints, spanPoints.size(), uSortSeed);
+
+    vecChangedTriangles.clear();
+    bTrackChangedTriangles = true;
+    bTrackRelinkedTriangles = true;
+
+    int iPreviousTriIndex = -1;
+    for (int i : vecOrder)
+    {
+        const Point& ptNew = spanPoints[i];
+
+        // A small batch is sparse in a large mesh, so the bucket grid (when enabled) is a closer start than the previous point
+        int iTriIndex = findContainingTriangle(ptNew, bUseGridIndex ? -1 : iPreviousTriIndex);
+        if (iTriIndex == -1)
+        {
+            continue;  // Outside of the mesh
+        }
+
+        const Triangle& triContaining = vecTriangles[iTriIndex];
+        bool bDuplicate = false;
+        for (int j = 0; j < 3; ++j)
+        {
+            const Point ptCorner = triContaining.getPoint(j);
+            bDuplicate = bDuplicate || (ptCorner.getX() == ptNew.getX() && ptCorner.getY() == ptNew.getY());
+        }
+        if (bDuplicate)
+        {
+            continue;
+        }
+
+        vecPtShape.push_back(ptNew);
+        insertPoint(iTriIndex, vecPtShape.size() - 1);
+        iPreviousTriIndex = iTriIndex;
+    }
+
+    bTrackChangedTriangles = false;
+    bTrackRelinkedTriangles = false;
+
+    // A slot changed by several insertions is reported once
+    std::sort(vecChangedTriangles.begin(), vecChangedTriangles.end());
+    vecChangedTriangles.erase(std::unique(vecChangedTriangles.begin(), vecChangedTriangles.end()), vecChangedTriangles.end());
+    vecChanged.swap(vecChangedTriangles);
+    return vecChanged;
+}
+
+// Removes a point with Devillers' ear queue. The triangles around the point form a star whose link polygon is clipped
+// ear by ear, always taking the convex ear whose circumcircle gives the removed point the largest power; that ear is
+// Delaunay, so the result is the Delaunay triangulation of the remaining points. The star is found from the incident
+// triangle hint of the point, the ears are chosen before the mesh is touched, then written into the star slots; only the
+// star and the triangles across the link edges change, and the two star slots left over go to the free list.
+bool Mesh::removePoint(int iPointIndex, std::vector<int>* pvecChanged)
+{
+    if (iPointIndex < 0 || iPointIndex >= vecPtShape.size() || isSuperPoint(iPointIndex))
+    {
+        std::cerr << "Invalid point index provided to removePoint." << std::endl;
+        return false;
+    }
+
+    const Point ptRemoved = vecPtShape[iPointIndex];
+
+    // Start from the incident triangle hint. Once complete, the hints are kept valid by onTriangleChanged, so only
+    // the first removal after a build or a renumbering refreshes all of them.
+    int iStart = iPointIndex < vecVertexTriangles.size() ? vecVertexTriangles[iPointIndex] : -1;
+    int iCorner = findVertexCorner(iStart, iPointIndex);
+    if (iCorner == -1 && !bVertexTrianglesComplete)
+    {
+        rebuildVertexTriangles();
+        iStart = vecVertexTriangles[iPointIndex];
+        iCorner = findVertexCorner(iStart, iPointIndex);
+    }
+    if (iCorner == -1)
+    {
+        std::cerr << "Point " << iPointIndex << " is not a vertex of the mesh." << std::endl;
+        return false;
+    }
+
+    // Turn counter-clockwise around the point: the star triangle (P, A, B) gives the link vertex A and the link edge A->B,
+    // and the next star triangle lies across B->P, where P starts the shared edge
+    vecRemovalStar.clear();
+    vecLinkPoints.clear();
+    vecLinkOuter.clear();
+    int iCurrent = iStart;
+    do
+    {
+        const Triangle& triCurrent = vecTriangles[iCurrent];
+        vecRemovalStar.push_back(iCurrent);
+        vecLinkPoints.push_back(triCurrent.getPointIndex((iCorner + 1) % 3));
+        vecLinkOuter.push_back(triCurrent.getNeighbourCorner((iCorner + 1) % 3));
+
+        const int iNextCorner = triCurrent.getNeighbourCorner((iCorner + 2) % 3);
+        if (iNextCorner == -1)
+        {
+            std::cerr << "Point " << iPointIndex << " lies on the boundary of the mesh and cannot be removed." << std::endl;
+            return false;
+        }
+        if (vecRemovalStar.size() > vecTriangles.size())
+        {
+            std::cerr << "The triangles around point " << iPointIndex << " do not close." << std::endl;
+            return false;
+        }
+
+        iCurrent = iNextCorner / 3;
+        iCorner = iNextCorner % 3;
+    } while (iCurrent != iStart);
+
+    // Choose the ears on the link polygon alone
+    const int iDegree = vecRemovalStar.size();
+    vecLinkPrev.resize(iDegree);
+    vecLinkNext.resize(iDegree);
+    vecLinkStamps.assign(iDegree, 0);
+    for (int j = 0; j < iDegree; ++j)
+    {
+        vecLinkPrev[j] = (j + iDegree - 1) % iDegree;
+        vecLinkNext[j] = (j + 1) % iDegree;
+    }
+
+    vecEarHeap.clear();
+    for (int j = 0; j < iDegree; ++j)
+    {
+        queueEar(j, ptRemoved);
+    }
+
+    vecEarSequence.clear();
+    int iRemaining = iDegree;
+    int iAliveVertex = 0;
+    while (iRemaining > 3)
+    {
+        if (vecEarHeap.empty())
+        {
+            std::cerr << "No convex ear is left around point " << iPointIndex << "." << std::endl;
+            return false;
+        }
+
+        std::pop_heap(vecEarHeap.begin(), vecEarHeap.end());
+        const EarCandidate ear = vecEarHeap.back();
+        vecEarHeap.pop_back();
+        if (ear.uStamp != vecLinkStamps[ear.iVertex])
+        {
+            continue;
+        }
+
+        const int iA = vecLinkPrev[ear.iVertex];
+        const int iC = vecLinkNext[ear.iVertex];
+        vecEarSequence.push_back(iA);
+        vecEarSequence.push_back(ear.iVertex);
+        vecEarSequence.push_back(iC);
+
+        ++vecLinkStamps[ear.iVertex];
+        vecLinkNext[iA] = iC;
+        vecLinkPrev[iC] = iA;
+        --iRemaining;
+        iAliveVertex = iA;
+
+        queueEar(iA, ptRemoved);
+        queueEar(iC, ptRemoved);
+    }
+    vecEarSequence.push_back(iAliveVertex);
+    vecEarSequence.push_back(vecLinkNext[iAliveVertex]);
+    vecEarSequence.push_back(vecLinkNext[vecLinkNext[iAliveVertex]]);
+
+    // The triangles across the link edges keep their shape but are relinked, and every star slot is rewritten or freed
+    const size_t uChangedStart = pvecChanged ? pvecChanged->size() : 0;
+    if (pvecChanged)
+    {
+        for (int iOuterCorner : vecLinkOuter)
+        {
+            if (iOuterCorner != -1)
+            {
+                pvecChanged->push_back(iOuterCorner / 3);
+            }
+        }
+        pvecChanged->insert(pvecChanged->end(), vecRemovalStar.begin(), vecRemovalStar.end());
+    }
+
+    // Write the ears into the star slots. vecLinkOuter follows the shrinking polygon: after an ear (A, B, C) is written,
+    // the corner outside the new edge A->C is edge 2 (C->A) of the ear.
+    const int iEarCount = iDegree - 2;
+    for (int e = 0; e < iEarCount; ++e)
+    {
+        const int iA = vecEarSequence[3 * e];
+        const int iB = vecEarSequence[3 * e + 1];
+        const int iC = vecEarSequence[3 * e + 2];
+        const int iSlot = vecRemovalStar[e];
+
+        vecTriangles[iSlot] = makeTriangle(iSlot, vecLinkPoints[iA], vecLinkPoints[iB], vecLinkPoints[iC]);
+        linkNeighbours(iSlot, 0, vecLinkOuter[iA]);
+        linkNeighbours(iSlot, 1, vecLinkOuter[iB]);
+
+        if (e == iEarCount - 1)
+        {
+            linkNeighbours(iSlot, 2, vecLinkOuter[iC]);  // The last ear closes the polygon
+        }
+        else
+        {
+            vecTriangles[iSlot].setNeighbourCorner(2, -1);  // Linked by the ear that uses the edge A->C
+            vecLinkOuter[iA] = 3 * iSlot + 2;
+        }
+    }
+
+    // The two star slots left over become free; no other triangle moves, so slots held by the caller stay valid
+    for (int e = iEarCount; e < iDegree; ++e)
+    {
+        const int iSlot = vecRemovalStar[e];
+        vecTriangles[iSlot] = Triangle();
+        vecTriangles[iSlot].setIndex(iSlot);
+        vecFreeTriangleSlots.push_back(iSlot);
+    }
+
+    for (int e = 0; e < iEarCount; ++e)
+    {
+        onTriangleChanged(vecRemovalStar[e]);
+    }
+
+    // An outer triangle bordering several link edges is reported once
+    if (pvecChanged)
+    {
+        std::sort(pvecChanged->begin() + uChangedStart, pvecChanged->end());
+        pvecChanged->erase(std::unique(pvecChanged->begin() + uChangedStart, pvecChanged->end()), pvecChanged->end());
+    }
+    return true;
+}
+
+// Queues the ear (prev, v, next) of the link polygon if it is strictly convex. Its priority is minus the incircle determinant
+// of the ear and the removed point over the orientation of the ear, which is the power of the point with respect
+// to the circumcircle, and the ear of largest power is Delaunay.
+void Mesh::queueEar(int iVertex, const Point& ptRemoved)
+{
+    ++vecLinkStamps[iVertex];
+
+    const Point& ptA = vecPtShape[vecLinkPoints[vecLinkPrev[iVertex]]];
+    const Point& ptB = vecPtShape[vecLinkPoints[iVertex]];
+    const Point& ptC = vecPtShape[vecLinkPoints[vecLinkNext[iVertex]]];
+
+    const double dOrientation = orient2d(ptA, ptB, ptC);
+    if (dOrientation <= 0)
+    {
+        return;
+    }
+
+    counters.add(MeshCounter::IncircleTests);
+    EarCandidate ear;
+    ear.dPriority = -incircle(ptA, ptB, ptC, ptRemoved) / dOrientation;
+    ear.iVertex = iVertex;
+    ear.uStamp = vecLinkStamps[iVertex];
+    vecEarHeap.push_back(ear);
+    std::push_heap(vecEarHeap.begin(), vecEarHeap.end());
+}
+
+// Takes the most recently freed triangle slot, or appends a new one, for a triangle about to be written
+int Mesh::allocateTriangleSlot()
+{
+    if (!vecFreeTriangleSlots.empty())
+    {
+        const int iSlot = vecFreeTriangleSlots.back();
+        vecFreeTriangleSlots.pop_back();
+        return iSlot;
+    }
+
+    vecTriangles.push_back(Triangle());
+    counters.add(MeshCounter::TrianglesAllocated);
+    return vecTriangles.size() - 1;
+}
+
+// Returns the corner of a live triangle slot that holds the point, or -1
+int Mesh::findVertexCorner(int iTriangleIndex, int iPointIndex) const
+{
+    if (iTriangleIndex < 0 || iTriangleIndex >= vecTriangles.size())
+    {
+        return -1;
+    }
+
+    const Triangle& triangle = vecTriangles[iTriangleIndex];
+    for (int j = 0; j < 3; ++j)
+    {
+        if (triangle.getPointIndex(j) == iPointIndex)
+        {
+            return j;
+        }
+    }
+    return -1;  // Also the answer for free slots, whose point indices are -1
+}
+
+// Recomputes the incident triangle hint of every point from the live triangles
+void Mesh::rebuildVertexTriangles()
+{
+    vecVertexTriangles.assign(vecPtShape.size(), -1);
+    for (const Triangle& triangle : vecTriangles)
+    {
+        for (int j = 0; !triangle.isFree() && j < 3; ++j)
+        {
+            vecVertexTriangles[triangle.getPointIndex(j)] = triangle.getIndex();
+        }
+    }
+    bVertexTrianglesComplete = true;
+}
+
+// Builds the mesh with the divide-and-conquer engine. The input points and the super triangle points are
+// triangulated together, so the super triangle is the hull of the result and the triangles match those of
+// the incremental engines (up to the choice among cocircular points), including the helper triangles.
+// In symbolic mode the super triangle points are treated as ordinary, distant points.
+void Mesh::buildMeshDivideAndConquer(int iPointCount)
+{
+    std::vector<int> vecPointIndices(iPointCount);
+    for (int i = 0; i < iPointCount; ++i)
+    {
+        vecPointIndices[i] = i;
+    }
+    for (int i = iPointCount; i < vecPtShape.size(); ++i)
+    {
+        vecPointIndices.push_back(i);
+    }
+
+    vecTriangles = DivideAndConquer::triangulate(vecPtShape, vecPointIndices, iThreadCount, &counters);
+    vecFreeTriangleSlots.clear();
+    bVertexTrianglesComplete = false;
+    counters.add(MeshCounter::TrianglesAllocated, vecTriangles.size());
+
+    // There is no insertion order, and every triangle slot was replaced
+    vecInsertionOrder.clear();
+    rebuildGridIndex();
+}
+
+// Finds the index of the triangle containing the target point using a jump-and-walk.
+// Without a starting triangle, about n^(1/3) triangles are sampled and the walk starts from the nearest one.
+// The walk is a remembering stochastic walk: it never goes back through the edge it came from and
+// picks the first edge to test at random, so it cannot cycle on degenerate configurations.
+int Mesh::findContainingTriangle(const Point& ptTargetPoint, int iStartIndex) const
+{
+    if (vecTriangles.empty())
+    {
+        return -1;
+    }
+
+    // A start out of range or in a free slot (the grid may still point at slots freed by removePoint) is no start
+    auto isLiveSlot = [this](int iIndex) {
+        return iIndex >= 0 && iIndex < vecTriangles.size() && !vecTriangles[iIndex].isFree();
+    };
+
+    // Seed the walk from the bucket grid when no valid starting triangle was given
+    if (!isLiveSlot(iStartIndex) && bUseGridIndex)
+    {
+        iStartIndex = gridIndex.getTriangle(ptTargetPoint);
+    }
+
+    // Otherwise jump to a nearby triangle
+    if (!isLiveSlot(iStartIndex))
+    {
+        iStartIndex = findJumpStart(ptTargetPoint);
+        if (iStartIndex == -1)
+        {
+            return -1;
+        }
+    }
+
+    std::uniform_int_distribution<> disEdge(0, 2);
+
+    int iCurrentIndex = iStartIndex;
+    int iEntryEdge = -1;  // Edge through which the walk entered the current triangle
+    const int iMaxSteps = static_cast<int>(vecTriangles.size());
+    int iSteps = 0;  // Triangles crossed so far
+
+    while (iSteps <= iMaxSteps)
+    {
+        const Triangle& triCurrent = vecTriangles[iCurrentIndex];
+
+        int iExitEdge = triCurrent.findExitEdge(ptTargetPoint, disEdge(genWalk), iEntryEdge);
+
+        if (iExitEdge == -1) // -1 indicates that the currentTri contains ptTargetPoint
+        {
+            counters.add(MeshCounter::WalkSteps, iSteps);
+            return iCurrentIndex;
+        }
+
+        int iNextCorner = triCurrent.getNeighbourCorner(iExitEdge);
+        if (iNextCorner == -1)
+        {
+            // The point lies outside of the triangulated region
+            counters.add(MeshCounter::WalkSteps, iSteps);
+            return -1;
+        }
+
+        iCurrentIndex = iNextCorner / 3;
+        iEntryEdge = iNextCorner % 3;
+        ++iSteps;
+    }
+
+    // The walk did not converge (inconsistent neighbours), fall back to a linear search
+    counters.add(MeshCounter::WalkSteps, iSteps);
+    for (const Triangle& triangle : vecTriangles)
+    {
+        if (!triangle.isFree() && triangle.contains(ptTargetPoint))
+        {
+            return triangle.getIndex();
+        }
+    }
+
+    // If no containing triangle is found, return -1
+    return -1;
+}
+
+// Samples about n^(1/3) triangles and returns the one whose first vertex is closest to the target point.
+// Free slots are skipped; if every sample is free, the first live triangle is used (-1 if there is none).
+int Mesh::findJumpStart(const Point& ptTargetPoint) const
+{
+    int iTriangleCount = static_cast<int>(vecTriangles.size());
+    int iSampleCount = std::max(1, static_cast<int>(std::cbrt(static_cast<double>(iTriangleCount))));
+
+    std::uniform_int_distribution<> dis(0, iTriangleCount - 1);
+
+    int iBestIndex = -1;
+    double dBestDistance = 0.0;
+
+    for (int i = 0; i < iSampleCount; ++i)
+    {
+        int iSampleIndex = dis(genWalk);
+        if (vecTriangles[iSampleIndex].isFree())
+        {
+            continue;
+        }
+
+        double dDistance = vecTriangles[iSampleIndex].getPoint(0).findSquaredDistance(ptTargetPoint);
+        if (iBestIndex == -1 || dDistance < dBestDistance)
+        {
+            dBestDistance = dDistance;
+            iBestIndex = iSampleIndex;
+        }
+    }
+
+    for (int i = 0; iBestIndex == -1 && i < iTriangleCount; ++i)
+    {
+        iBestIndex = vecTriangles[i].isFree() ? -1 : i;
+    }
+
+    return iBestIndex;
+}
+
+// Returns a snapshot of the hot-path counters of every thread and of the phase timings
+MeshStats Mesh::stats() const
+{
+    return counters.snapshot();
+}
+
+// Zeroes the hot-path counters and phase timings
+void Mesh::resetStats()
+{
+    counters.reset();
+}
+
+// Enables the bucket-grid point location index and builds it from the current triangles
+void Mesh::enableGridIndex(int iCellsPerAxis)
+{
+    bUseGridIndex = true;
+    iGridCellsPerAxis = iCellsPerAxis;
+    rebuildGridIndex();
+}
+
+// Disables the bucket-grid point location index
+void Mesh::disableGridIndex()
+{
+    bUseGridIndex = false;
+    gridIndex.clear();
+}
+
+// Returns whether the bucket-grid point location index is enabled
+bool Mesh::hasGridIndex() const
+{
+    return bUseGridIndex;
+}
+
+// Rebuilds the bucket grid over the bounding box of the points from the current triangles
+void Mesh::rebuildGridIndex()
+{
+    if (!bUseGridIndex || vecPtShape.empty())
+    {
+        gridIndex.clear();
+        return;
+    }
+
+    // Queries target the input points, so the super triangle points are left out of the bounding box
+    bool bFirst = true;
+    float fMinX = 0.0f, fMaxX = 0.0f, fMinY = 0.0f, fMaxY = 0.0f;
+
+    for (int i = 0; i < vecPtShape.size(); ++i)
+    {
+        if (isSuperPoint(i)) { continue; }
+
+        const Point& pt = vecPtShape[i];
+        if (bFirst)
+        {
+            fMinX = fMaxX = pt.getX();
+            fMinY = fMaxY = pt.getY();
+            bFirst = false;
+        }
+
+        fMinX = std::min(fMinX, pt.getX());
+        fMaxX = std::max(fMaxX, pt.getX());
+        fMinY = std::min(fMinY, pt.getY());
+        fMaxY = std::max(fMaxY, pt.getY());
+    }
+
+    // Aim for about two triangles per cell once the mesh is built
+    int iCellsPerAxis = iGridCellsPerAxis;
+    if (iCellsPerAxis <= 0)
+    {
+        size_t iExpectedTriangles = std::max(vecTriangles.size(), 2 * vecPtShape.size());
+        iCellsPerAxis = std::max(1, static_cast<int>(std::sqrt(iExpectedTriangles / 2.0)));
+    }
+
+    gridIndex.reset(fMinX, fMinY, fMaxX, fMaxY, iCellsPerAxis, iCellsPerAxis);
+
+    for (const Triangle& triangle : vecTriangles)
+    {
+        if (!triangle.isFree())
+        {
+            gridIndex.update(triangle);
+        }
+    }
+}
+
+// Notifies the acceleration structures that a triangle slot was reused or appended
+void Mesh::onTriangleChanged(int iTriangleIndex)
+{
+    const Triangle& triangle = vecTriangles[iTriangleIndex];
+    if (bUseGridIndex)
+    {
+        gridIndex.update(triangle);
+    }
+
+    // Every slot written by createTriangles, handleEdgeCase, flipEdge, fillCavity or removePoint passes here, so the
+    // slot becomes the incident triangle hint of its corners; as each of them rewrites all the triangles around the
+    // vertices it touches, a complete set of hints stays valid
+    if (vecVertexTriangles.size() < vecPtShape.size())
+    {
+        vecVertexTriangles.resize(vecPtShape.capacity(), -1);
+    }
+    for (int j = 0; j < 3; ++j)
+    {
+        vecVertexTriangles[triangle.getPointIndex(j)] = iTriangleIndex;
+    }
+
+    // During refinement the slot is queued again once the insertion is complete, and older entries become stale
+    if (bTrackChangedTriangles)
+    {
+        if (iTriangleIndex >= vecTriangleVersions.size())
+        {
+            vecTriangleVersions.resize(iTriangleIndex + 1, 0);
+        }
+        ++vecTriangleVersions[iTriangleIndex];
+        vecChangedTriangles.push_back(iTriangleIndex);
+    }
+}
+
+// Sets how the super triangle is placed around the points
+void Mesh::setSuperTriangleMode(SuperTriangleMode eMode)
+{
+    eSuperTriangleMode = eMode;
+}
+
+// Returns how the super triangle is placed around the points
+SuperTriangleMode Mesh::getSuperTriangleMode() const
+{
+    return eSuperTriangleMode;
+}
+
+// Sets the margin of the super triangle, relative to the half diagonal of the bounding box
+void Mesh::setSuperTriangleMargin(double dMargin)
+{
+    dSuperTriangleMargin = std::max(dMargin, 0.0);
+}
+
+// Returns the margin of the super triangle
+double Mesh::getSuperTriangleMargin() const
+{
+    return dSuperTriangleMargin;
+}
+
+// Creates a super triangle that encloses all points in the mesh.
+// The triangle is equilateral and circumscribes the circle around the bounding box of vecPtShape,
+// enlarged by the configured margin; in symbolic mode its vertices are pushed far away and treated
+// as points at infinity by the conflict test.
+Triangle Mesh::superTriangle()
+{
+    // Bounding box of the input points
+    double dMinX = 0.0, dMaxX = 0.0, dMinY = 0.0, dMaxY = 0.0;
+    if (!vecPtShape.empty())
+    {
+        dMinX = dMaxX = vecPtShape[0].getX();
+        dMinY = dMaxY = vecPtShape[0].getY();
+    }
+
+    for (const Point& pt : vecPtShape)
+    {
+        dMinX = std::min(dMinX, static_cast<double>(pt.getX()));
+        dMaxX = std::max(dMaxX, static_cast<double>(pt.getX()));
+        dMinY = std::min(dMinY, static_cast<double>(pt.getY()));
+        dMaxY = std::max(dMaxY, static_cast<double>(pt.getY()));
+    }
+
+    // Radius of the circle enclosing the bounding box plus the margin
+    double dCenterX = 0.5 * (dMinX + dMaxX);
+    double dCenterY = 0.5 * (dMinY + dMaxY);
+    double dRadius = 0.5 * std::sqrt((dMaxX - dMinX) * (dMaxX - dMinX) + (dMaxY - dMinY) * (dMaxY - dMinY));
+
+    if (dRadius == 0)
+    {
+        dRadius = 1.0; // All points coincide (or there are none)
+    }
+
+    dRadius *= 1.0 + dSuperTriangleMargin;
+
+    if (eSuperTriangleMode == SuperTriangleMode::Symbolic)
+    {
+        dRadius *= SYMBOLIC_SUPER_TRIANGLE_SCALE;
+    }
+
+    // Equilateral triangle circumscribing that circle, in counter-clockwise order
+    const double dSqrt3 = std::sqrt(3.0);
+    Point p0(dCenterX - dSqrt3 * dRadius, dCenterY - dRadius);
+    Point p1(dCenterX + dSqrt3 * dRadius, dCenterY - dRadius);
+    Point p2(dCenterX, dCenterY + 2.0 * dRadius);
+
+    Triangle triSuper = Triangle(p0, p1, p2);
+
+    // Append points to the end of vecPtShape
+    iSuperPointIndex = vecPtShape.size();
+    triSuper.setPointIndex(0, vecPtShape.size());
+    vecPtShape.push_back(p0);
+    triSuper.setPointIndex(1, vecPtShape.size());
+    vecPtShape.push_back(p1);
+    triSuper.setPointIndex(2, vecPtShape.size());
+    vecPtShape.push_back(p2);
+
+    triSuper.setIndex(0);
+
+    return triSuper;
+}
+
+// Checks whether a point index refers to one of the super triangle points
+bool Mesh::isSuperPoint(int iPointIndex) const
+{
+    return iSuperPointIndex >= 0 && iPointIndex >= iSuperPointIndex && iPointIndex < iSuperPointIndex + 3;
 }
 
-// Builds the mesh by iterating through all points in vecPtShape.
-void Mesh::buildMesh()
+// Checks whether a point lies inside the circumcircle of a triangle.
+// In symbolic mode a triangle with exactly one super point is treated as having that vertex at infinity:
+// its circumcircle degenerates to the open half-plane on the far side of its real edge.
+bool Mesh::isInConflict(int iTriangleIndex, const Point& pt) const
 {
-    int iPointIndex = 0;
+    const Triangle& triangle = vecTriangles[iTriangleIndex];
 
-    for (auto point : vecPtShape)
+    if (eSuperTriangleMode == SuperTriangleMode::Symbolic)
     {
-        // Find the triangle that contains the current point
-        int iTriIndex = findContainingTriangle(point);
+        int iSuperCount = 0, iSuperCorner = -1;
+        for (int i = 0; i < 3; ++i)
+        {
+            if (isSuperPoint(triangle.getPointIndex(i)))
+            {
+                ++iSuperCount;
+                iSuperCorner = i;
+            }
+        }
 
-        // Create new triangles from the found triangle and current point
-        createTriangles(iTriIndex, iPointIndex);
+        if (iSuperCount == 1)
+        {
+            // The real edge runs from the corner after the super point to the one before it
+            const Point ptA = triangle.getPoint((iSuperCorner + 1) % 3);
+            const Point ptB = triangle.getPoint((iSuperCorner + 2) % 3);
 
-        iPointIndex += 1;  // Move to the next point
+            double dOrientation = orient2d(ptA, ptB, pt);
+            if (dOrientation != 0)
+            {
+                return dOrientation > 0; // The super point lies to the left of A->B
+            }
 
-        // Stop processing when the last three points (super triangle points) are reached
-        if ((vecPtShape.size() - 3) == iPointIndex) { break; }
+            // On the supporting line: only the open segment is inside the degenerate circle
+            double dAbx = static_cast<double>(ptB.getX()) - ptA.getX();
+            double dAby = static_cast<double>(ptB.getY()) - ptA.getY();
+            double dDot = dAbx * (static_cast<double>(pt.getX()) - ptA.getX()) + dAby * (static_cast<double>(pt.getY()) - ptA.getY());
+            return dDot > 0 && dDot < dAbx * dAbx + dAby * dAby;
+        }
     }
+
+    counters.add(MeshCounter::IncircleTests);
+    return triangle.isInCircumcircle(pt);
 }
 
-// Finds the index of the triangle contaiCurrentNeighbourng the target point
-int Mesh::findContainingTriangle(const Point& ptTargetPoint) const
+// Tests several triangles for conflict with a point at once.
+// Triangles touching a symbolic super point follow the rule of isInConflict; the others are gathered into
+// coordinate arrays and tested with the batched incircle kernel (the mesh triangles are counter-clockwise).
+void Mesh::findConflicts(const std::vector<int>& vecCandidates, const Point& pt, std::vector<char>& vecConflict) const
 {
-    // iCurrentNeighbourtialize random number generator
-    static std::random_device rd;  // Seed
-    static std::mt19937 gen(rd()); // Mersenne Twister RNG
-
+    const int iCount = vecCandidates.size();
+    vecConflict.assign(iCount, 0);
 
-    // Size of vecTriangles should change everytime method is called
-    std::uniform_int_distribution<> dis(0, vecTriangles.size() - 1);
-
-    // Get a randomized triangle from vecTriangles
-    int iRandomIndex = dis(gen);
+    vecConflictLanes.clear();
+    if (vecConflictScratch.size() < 7 * iCount)
+    {
+        vecConflictScratch.resize(7 * iCount);
+    }
 
-    // Initialize stack for DFS
-    std::stack<int> stackTriangles;
-    stackTriangles.push(iRandomIndex);
+    double* pdAx = vecConflictScratch.data();
+    double* pdAy = pdAx + iCount;
+    double* pdBx = pdAy + iCount;
+    double* pdBy = pdBx + iCount;
+    double* pdCx = pdBy + iCount;
+    double* pdCy = pdCx + iCount;
+    double* pdResult = pdCy + iCount;
 
-    while (!stackTriangles.empty())
+    for (int k = 0; k < iCount; ++k)
     {
-        int iCurrentIndex = stackTriangles.top();
-        stackTriangles.pop();
-
-        const Triangle& triCurrent = vecTriangles[iCurrentIndex];
-        int iResult = triCurrent.findPathToContainingTriangle(ptTargetPoint);
+        const Triangle& triangle = vecTriangles[vecCandidates[k]];
 
-        if (iResult == -1) // -1 indicates that the currentTri contains ptTargetPoint
-        {
-            return triCurrent.getIndex();
-        }
-        else
+        if (eSuperTriangleMode == SuperTriangleMode::Symbolic &&
+            (isSuperPoint(triangle.getPointIndex(0)) || isSuperPoint(triangle.getPointIndex(1)) || isSuperPoint(triangle.getPointIndex(2))))
         {
-            stackTriangles.push(iResult);
+            vecConflict[k] = isInConflict(vecCandidates[k], pt);
+            continue;
         }
-    }
-
-    // If no contaiCurrentNeighbouring triangle is found, return -1 or handle error appropriately
-    return -1;
-}
-
-// Creates a super triangle that encloses all points in the mesh
-Triangle Mesh::superTriangle()
-{
-    Point p0(0, 0);
-    Point p1(30, 0);
-    Point p2(15, 25.981);
-
-    Triangle triSuper = Triangle(p0, p1, p2);
-    triSuper.setPointIndex(0, vecPtShape.size());
-    vecPtShape.push_back(p0);
-    triSuper.setPointIndex(1, vecPtShape.size());
-    vecPtShape.push_back(p1);
-    triSuper.setPointIndex(2, vecPtShape.size());
-    vecPtShape.push_back(p2);
 
-    // Append points to the end of vecPtShape
+        const int iLane = vecConflictLanes.size();
+        pdAx[iLane] = triangle.getPoint(0).getX();
+        pdAy[iLane] = triangle.getPoint(0).getY();
+        pdBx[iLane] = triangle.getPoint(1).getX();
+        pdBy[iLane] = triangle.getPoint(1).getY();
+        pdCx[iLane] = triangle.getPoint(2).getX();
+        pdCy[iLane] = triangle.getPoint(2).getY();
+        vecConflictLanes.push_back(k);
+    }
 
-    triSuper.setIndex(0);
+    incircleBatch(pdAx, pdAy, pdBx, pdBy, pdCx, pdCy, vecConflictLanes.size(), pt.getX(), pt.getY(), pdResult);
+    counters.add(MeshCounter::IncircleTests, vecConflictLanes.size());
 
-    return triSuper;
+    for (int iLane = 0; iLane < vecConflictLanes.size(); ++iLane)
+    {
+        vecConflict[vecConflictLanes[iLane]] = pdResult[iLane] > 0;
+    }
 }
 
 // Removes the helper triangles that include points of the super triangle.
 void Mesh::removeHelperTriangles()
 {
-    std::vector<int> trianglesToRemove;  // Vector to store indices of triangles to be removed
+    ScopedPhase phase(counters, MeshPhase::HelperRemoval);
+
+    std::vector<char> vecRemove(vecTriangles.size(), 0);  // Flags of the triangles to be removed
 
     // Iterate over all triangles in the mesh
     for (int i = 0; i < vecTriangles.size(); ++i)
     {
         const Triangle& triangle = vecTriangles[i];
 
+        // Free slots have no neighbours and are dropped with the helper triangles
+        if (triangle.isFree())
+        {
+            vecRemove[i] = 1;
+            continue;
+        }
+
         // Check each point in the current triangle
         for (int j = 0; j < 3; ++j)
         {
             // If a point in the triangle belongs to the super triangle (helper points)
-            if (triangle.getPointIndex(j) >= vecPtShape.size() - 3)
+            if (isSuperPoint(triangle.getPointIndex(j)))
             {
                 // Mark this triangle for removal
-                trianglesToRemove.push_back(i);
+                vecRemove[i] = 1;
 
                 // Update the neighbors of the triangle being removed
                 updateRemovedNeighbours(triangle.getIndex());
@@ -143,56 +1030,83 @@ void Mesh::removeHelperTriangles()
         }
     }
 
-    // Remove the triangles marked for deletion, starting from the end to avoid index issues
-    for (int i = trianglesToRemove.size() - 1; i >= 0; --i)
+    // Move the remaining triangles down in a single pass, keeping their order; they keep their
+    // old index until updateTriangleIndicesAfterRemoval remaps the neighbour references
+    int iWriteIndex = 0;
+    for (int i = 0; i < vecTriangles.size(); ++i)
     {
-        vecTriangles.erase(vecTriangles.begin() + trianglesToRemove[i]);
+        if (vecRemove[i]) continue;
+        if (iWriteIndex != i)
+        {
+            vecTriangles[iWriteIndex] = vecTriangles[i];
+        }
+        ++iWriteIndex;
     }
+    vecTriangles.resize(iWriteIndex);
+    vecFreeTriangleSlots.clear();
+    bVertexTrianglesComplete = false;
 
-    // Remove the last three points corresponding to the super triangle
-    vecPtShape.resize(vecPtShape.size() - 3);
+    // Remove the three points of the super triangle; points added after them (by insertPoints or the refinement)
+    // move down by three
+    if (iSuperPointIndex >= 0)
+    {
+        const int iFirstMovedPoint = iSuperPointIndex + 3;
+        if (iFirstMovedPoint < vecPtShape.size())
+        {
+            for (Triangle& triangle : vecTriangles)
+            {
+                for (int j = 0; j < 3; ++j)
+                {
+                    if (triangle.getPointIndex(j) >= iFirstMovedPoint)
+                    {
+                        triangle.setPointIndex(j, triangle.getPointIndex(j) - 3);
+                    }
+                }
+            }
+        }
+        vecPtShape.erase(vecPtShape.begin() + iSuperPointIndex, vecPtShape.begin() + iFirstMovedPoint);
+        iSuperPointIndex = -1;
+    }
 
     // Update triangle indices to reflect the removal
     updateTriangleIndicesAfterRemoval();
+
+    // Triangle slots were renumbered, so the bucket grid has to be rebuilt
+    rebuildGridIndex();
 }
 
 // Updates triangle indices after some triangles have been removed.
+// The remaining triangles still carry their old index, so a table mapping old indices to new slots
+// is built first and every neighbour corner is then rewritten in one linear sweep.
 void Mesh::updateTriangleIndicesAfterRemoval()
 {
-    // Iterate through all remaining triangles
+    // Size the remap table by the largest old index
+    int iOldCount = 0;
+    for (const Triangle& triangle : vecTriangles)
+    {
+        iOldCount = std::max(iOldCount, triangle.getIndex() + 1);
+    }
+
+    // Old index -> new index (-1 for triangles that no longer exist)
+    std::vector<int> vecRemap(iOldCount, -1);
+    for (int iTriangleIndex = 0; iTriangleIndex < vecTriangles.size(); ++iTriangleIndex)
+    {
+        vecRemap[vecTriangles[iTriangleIndex].getIndex()] = iTriangleIndex;
+    }
+
+    // Renumber the triangles and redirect their neighbour corners, keeping the edge part of each corner
     for (int iTriangleIndex = 0; iTriangleIndex < vecTriangles.size(); ++iTriangleIndex)
     {
         Triangle& currentTriangle = vecTriangles[iTriangleIndex];
-        int iOldIndex = currentTriangle.getIndex();  // Get the current triangle index
+        currentTriangle.setIndex(iTriangleIndex);
 
-        // Update the triangle's index if it has changed
-        if (iOldIndex != iTriangleIndex)
+        for (int i = 0; i < 3; ++i)
         {
-            currentTriangle.setIndex(iTriangleIndex);
-
-            // Update the neighbors of the current triangle to reference the new index
-            for (int i = 0; i < 3; ++i)
-            {
-                int iTriangleNeighbourIndex = currentTriangle.getNeighbourIndex(i);
-                if (iTriangleNeighbourIndex == -1) continue;  // Skip if no neighbor
+            int iNeighbourCorner = currentTriangle.getNeighbourCorner(i);
+            if (iNeighbourCorner == -1) continue;  // Skip if no neighbor
 
-                // Iterate through all triangles to find and update the neighbor's references
-                for (Triangle& triNeighbour : vecTriangles)
-                {
-                    if (triNeighbour.getIndex() == iTriangleNeighbourIndex)
-                    {
-                        // Update the specific neighbor reference to the new index
-                        for (int j = 0; j < 3; ++j)
-                        {
-                            if (triNeighbour.getNeighbourIndex(j) == iOldIndex)
-                            {
-                                triNeighbour.setNeighbourIndex(j, iTriangleIndex);
-                                break;  // Exit loop once the neighbor is updated
-                            }
-                        }
-                    }
-                }
-            }
+            int iNewNeighbour = iNeighbourCorner / 3 < iOldCount ? vecRemap[iNeighbourCorner / 3] : -1;
+            currentTriangle.setNeighbourCorner(i, iNewNeighbour == -1 ? -1 : 3 * iNewNeighbour + iNeighbourCorner % 3);
         }
     }
 }
@@ -205,1092 +1119,1038 @@ void Mesh::updateRemovedNeighbours(int iRemovedTriangleIndex)
     // Iterate through each edge of the removed triangle
     for (int i = 0; i < 3; ++i)
     {
-        int removedNeighborIndex = triRemoved.getNeighbourIndex(i);
-        if (removedNeighborIndex == -1) continue;  // Skip if no neighbor
-
-        Triangle& triNeighbour = vecTriangles[removedNeighborIndex];
+        int iNeighbourCorner = triRemoved.getNeighbourCorner(i);
+        if (iNeighbourCorner == -1) continue;  // Skip if no neighbor
 
         // Update the neighbor reference to indicate it no longer has a neighbor on this edge
-        for (int j = 0; j < 3; ++j)
-        {
-            if (triNeighbour.getNeighbourIndex(j) == iRemovedTriangleIndex)
-            {
-                triNeighbour.setNeighbourIndex(j, -1);  // Mark as no neighbor
-            }
-        }
+        vecTriangles[iNeighbourCorner / 3].setNeighbourCorner(iNeighbourCorner % 3, -1);
     }
 }
 
-// Creates new triangles by splitting an existing triangle based on the provided point index.
-void Mesh::createTriangles(int iTriangleIndex, int iPointIndex)
+// Sets the engine used to insert points into the triangulation
+void Mesh::setInsertionEngine(InsertionEngine eEngine)
 {
-    // Validate indices to ensure they are within bounds
-    if (iTriangleIndex < 0 || iTriangleIndex >= vecTriangles.size() || iPointIndex < 0 || iPointIndex >= vecPtShape.size()) {
-        std::cerr << "Invalid indices provided to createTriangles." << std::endl;
-        return;
-    }
+    eInsertionEngine = eEngine;
+}
 
-    // Reference to the target point in vecPtShape
-    const Point& ptTargetPoint = vecPtShape[iPointIndex];
-    // Reference to the triangle being split
-    Triangle& triCurrent = vecTriangles[iTriangleIndex];
+// Returns the engine used to insert points into the triangulation
+InsertionEngine Mesh::getInsertionEngine() const
+{
+    return eInsertionEngine;
+}
 
-    // Check if the target point lies inside the triangle but not on any edge
-    if (triCurrent.onEdge(ptTargetPoint) < 0)
+// Inserts a point into the triangle that contains it using the selected engine
+void Mesh::insertPoint(int iTriangleIndex, int iPointIndex)
+{
+    if (eInsertionEngine == InsertionEngine::BowyerWatson)
     {
-        // Create two new triangles using two points from the current triangle and the target point
-        Triangle triNewTriangle1(triCurrent.getPoint(0), triCurrent.getPoint(1), ptTargetPoint);
-        Triangle triNewTriangle2(triCurrent.getPoint(1), triCurrent.getPoint(2), ptTargetPoint);
-
-        // Set the indices for the new triangles
-        int iNewIndex1 = vecTriangles.size();
-        int iNewIndex2 = iNewIndex1 + 1;
-        triNewTriangle1.setIndex(iNewIndex1);
-        triNewTriangle2.setIndex(iNewIndex2);
-
-        // Set the point indices for the new triangles
-        triNewTriangle1.setPointIndex(0, triCurrent.getPointIndex(0));
-        triNewTriangle1.setPointIndex(1, triCurrent.getPointIndex(1));
-        triNewTriangle1.setPointIndex(2, iPointIndex);
-
-        triNewTriangle2.setPointIndex(0, triCurrent.getPointIndex(1));
-        triNewTriangle2.setPointIndex(1, triCurrent.getPointIndex(2));
-        triNewTriangle2.setPointIndex(2, iPointIndex);
-
-        // Update the current triangle with the new point and its index
-        triCurrent.setPointIndex(1, iPointIndex);
-        triCurrent.setPoint(1, ptTargetPoint);
-
-        // Update neighbors for the new triangles
-        triNewTriangle1.setNeighbourIndex(2, iTriangleIndex); // Set the current triangle as a neighbor
-        triNewTriangle2.setNeighbourIndex(1, iTriangleIndex);
-
-        // Set the new triangles as neighbors of each other
-        triNewTriangle1.setNeighbourIndex(1, iNewIndex2);
-        triNewTriangle2.setNeighbourIndex(2, iNewIndex1);
-
-        // Save the old neighbors of the current triangle
-        int iOldNeighbourIndex1 = triCurrent.getNeighbourIndex(0);
-        int iOldNeighbourIndex2 = triCurrent.getNeighbourIndex(1);
-
-        // Update the current triangle's neighbors to point to the new triangles
-        triCurrent.setNeighbourIndex(0, iNewIndex1);
-        triCurrent.setNeighbourIndex(1, iNewIndex2);
-
-        // Update the old neighbor of the current triangle to point to the new triangle
-        if (iOldNeighbourIndex1 != -1)
-        {
-            Triangle& triOldNeighbour = vecTriangles[iOldNeighbourIndex1];
-            for (int i = 0; i < 3; ++i)
-            {
-                if (triOldNeighbour.getNeighbourIndex(i) == iTriangleIndex)
-                {
-                    triOldNeighbour.setNeighbourIndex(i, iNewIndex1);
-                    break;
-                }
-            }
-            triNewTriangle1.setNeighbourIndex(0, iOldNeighbourIndex1);
-        }
-
-        // Repeat the neighbor update process for the second neighbor
-        if (iOldNeighbourIndex2 != -1)
-        {
-            Triangle& triOldNeighbour = vecTriangles[iOldNeighbourIndex2];
-            for (int i = 0; i < 3; ++i)
-            {
-                if (triOldNeighbour.getNeighbourIndex(i) == iTriangleIndex)
-                {
-                    triOldNeighbour.setNeighbourIndex(i, iNewIndex2);
-                    break;
-                }
-            }
-            triNewTriangle2.setNeighbourIndex(0, iOldNeighbourIndex2);
-        }
-
-        // Add the new triangles to the mesh's triangle list
-        vecTriangles.push_back(triNewTriangle1);
-        vecTriangles.push_back(triNewTriangle2);
-
-        // Check the circumcircles of the new triangles and swap edges if necessary to maintain the Delaunay condition
-        if (vecTriangles[iTriangleIndex].getNeighbourIndex(2) != -1 && vecTriangles[vecTriangles[iTriangleIndex].getNeighbourIndex(2)].isInCircumcircle(ptTargetPoint))
-        {
-            std::queue<int> neighbourQueue = checkNeighboringCircumcircles(iTriangleIndex, iPointIndex, 2);
-            swapAll(neighbourQueue, iPointIndex);
-        }
-
-        if (vecTriangles[iNewIndex1].getNeighbourIndex(0) != -1 && vecTriangles[vecTriangles[iNewIndex1].getNeighbourIndex(0)].isInCircumcircle(ptTargetPoint))
-        {
-            std::queue<int> neighbourQueue = checkNeighboringCircumcircles(iNewIndex1, iPointIndex, 0);
-            swapAll(neighbourQueue, iPointIndex);
-        }
-
-        if (vecTriangles[iNewIndex2].getNeighbourIndex(0) != -1 && vecTriangles[vecTriangles[iNewIndex2].getNeighbourIndex(0)].isInCircumcircle(ptTargetPoint))
-        {
-            std::queue<int> neighbourQueue = checkNeighboringCircumcircles(iNewIndex2, iPointIndex, 0);
-            swapAll(neighbourQueue, iPointIndex);
-        }
+        insertPointBowyerWatson(iTriangleIndex, iPointIndex);
     }
     else
     {
-        // Handle cases where the target point lies on an edge of the current triangle
-        handleEdgeCase(iTriangleIndex, iPointIndex);
+        createTriangles(iTriangleIndex, iPointIndex);
     }
 }
 
-// Handles special edge cases when a triangle's edge is processed or modified.
-void Mesh::handleEdgeCase(int iTriangleIndex, int iPointIndex)
+// Appends a point to the shape; it takes part in the mesh once passed to insertPoint
+int Mesh::addPoint(const Point& pt)
 {
-    {
-        // Reference to the point being processed and the triangle that is being split
-        const Point& ptTargetPoint = vecPtShape[iPointIndex];
-        Triangle& triCurrent = vecTriangles[iTriangleIndex];
+    vecPtShape.push_back(pt);
+    return vecPtShape.size() - 1;
+}
+
+// Inserts a point with the Bowyer-Watson algorithm: the triangles whose circumcircle contains the point
+// are collected by walking the adjacency from the containing triangle, and the resulting cavity is
+// retriangulated as a star around the new point, reusing the cavity slots for the new triangles.
+void Mesh::insertPointBowyerWatson(int iTriangleIndex, int iPointIndex)
+{
+    // Validate indices to ensure they are within bounds
+    if (iTriangleIndex < 0 || iTriangleIndex >= vecTriangles.size() || iPointIndex < 0 || iPointIndex >= vecPtShape.size()) {
+        std::cerr << "Invalid indices provided to insertPointBowyerWatson." << std::endl;
+        return;
+    }
 
-        // Create a new triangle that will be used to split the current triangle
-        Triangle triNewTriangle1;
-        int iNewIndex1 = vecTriangles.size();
-        triNewTriangle1.setIndex(iNewIndex1);
+    const Point ptTargetPoint = vecPtShape[iPointIndex];
 
-        // Handle case where the point is on Edge 0 (pt0 to pt1)
-        if(triCurrent.onEdge(ptTargetPoint) == 0)
-        {
-            // Set points for the new triangle and update indices
-            triNewTriangle1.setPoint(0, triCurrent.getPoint(1));
-            triNewTriangle1.setPoint(1, triCurrent.getPoint(2));
-            triNewTriangle1.setPoint(2, ptTargetPoint);
+    std::vector<int>& vecCavity = vecCavityScratch;
+    std::vector<CavityEdge>& vecBoundary = vecBoundaryScratch;
+    std::vector<int>& vecCandidates = vecCandidateScratch;
+    std::vector<char>& vecConflict = vecConflictScratchFlags;
+    vecCavity.clear();
+
+    // Cavity triangles carry the cavity epoch; the candidates of a wave carry the wave epoch, or the one after it when in conflict
+    const unsigned long long uCavityEpoch = nextMarkEpochs(1);
+    auto inCavity = [this, uCavityEpoch](int iIndex) {
+        return vecTriangleMarks[iIndex] == uCavityEpoch;
+    };
 
-            triNewTriangle1.setPointIndex(0, triCurrent.getPointIndex(1));
-            triNewTriangle1.setPointIndex(1, triCurrent.getPointIndex(2));
-            triNewTriangle1.setPointIndex(2, iPointIndex);
+    vecCavity.push_back(iTriangleIndex);
+    vecTriangleMarks[iTriangleIndex] = uCavityEpoch;
 
-            // Set neighbor relationships for the new triangle
-            triNewTriangle1.setNeighbourIndex(1, iTriangleIndex);
-            triNewTriangle1.setNeighbourIndex(0, triCurrent.getNeighbourIndex(1));
+    bool bGrown = true;
+    while (bGrown)
+    {
+        bGrown = false;
+        vecBoundary.clear();
 
-            int iOldNeighbourIndex1 = triCurrent.getNeighbourIndex(1);
+        // Grow the cavity by adjacency and collect its boundary edges, one breadth-first wave at a time:
+        // the neighbours of a wave are tested for conflict in a single batch, then the wave is processed in order
+        size_t iWaveStart = 0;
+        while (iWaveStart < vecCavity.size())
+        {
+            const size_t iWaveEnd = vecCavity.size();
+            const unsigned long long uWaveEpoch = nextMarkEpochs(2);
+            const unsigned long long uConflictEpoch = uWaveEpoch + 1;
 
-            // Update the old neighbor to reference the new triangle
-            if (iOldNeighbourIndex1 != -1)
+            vecCandidates.clear();
+            for (size_t k = iWaveStart; k < iWaveEnd; ++k)
             {
-                Triangle& triOldNeighbour = vecTriangles[iOldNeighbourIndex1];
                 for (int i = 0; i < 3; ++i)
                 {
-                    if (triOldNeighbour.getNeighbourIndex(i) == iTriangleIndex)
+                    int iNeighbourIndex = vecTriangles[vecCavity[k]].getNeighbourIndex(i);
+                    if (iNeighbourIndex != -1 && !inCavity(iNeighbourIndex) && vecTriangleMarks[iNeighbourIndex] != uWaveEpoch)
                     {
-                        triOldNeighbour.setNeighbourIndex(i, iNewIndex1);
-                        break;
+                        vecTriangleMarks[iNeighbourIndex] = uWaveEpoch;
+                        vecCandidates.push_back(iNeighbourIndex);
                     }
                 }
             }
 
-            // Update the current triangle to include the new point
-            triCurrent.setPointIndex(1, iPointIndex);
-            triCurrent.setPoint(1, ptTargetPoint);
-            triCurrent.setNeighbourIndex(1, iNewIndex1);
-
-            const int iOldNeighbour = triCurrent.getNeighbourIndex(0);
-            triCurrent.setNeighbourIndex(0, -1);
-
-            // Add the new triangle to the list of triangles
-            vecTriangles.push_back(triNewTriangle1);
-
-            // Update references to the current and new triangles
-            triCurrent = vecTriangles[iTriangleIndex];
-            triNewTriangle1 = vecTriangles[iNewIndex1];
+            findConflicts(vecCandidates, ptTargetPoint, vecConflict);
 
-            // Check and handle circumcircles for possible swaps
-            const Triangle& triNeighbour0 = vecTriangles[triCurrent.getNeighbourIndex(2)];
-            const Triangle& triNeighbour1 = vecTriangles[triNewTriangle1.getNeighbourIndex(0)];
-
-            if (triNeighbour0.isInCircumcircle(ptTargetPoint))
+            for (size_t k = 0; k < vecCandidates.size(); ++k)
             {
-                std::queue<int> neighbourQueue = checkNeighboringCircumcircles(iTriangleIndex, iPointIndex, 2);
-                swapAll(neighbourQueue, iPointIndex);
-
-                if (areNeighbours(iTriangleIndex, iNewIndex1))
+                if (vecConflict[k])
                 {
-                    iTriangleIndex = triNeighbour0.getIndex();
+                    vecTriangleMarks[vecCandidates[k]] = uConflictEpoch;
                 }
             }
 
-            if (triNeighbour1.isInCircumcircle(ptTargetPoint))
+            for (size_t k = iWaveStart; k < iWaveEnd; ++k)
             {
-                std::queue<int> neighbourQueue = checkNeighboringCircumcircles(iNewIndex1, iPointIndex, 0);
-                swapAll(neighbourQueue, iPointIndex);
+                const int iCurrentIndex = vecCavity[k];
 
-                if (areNeighbours(iTriangleIndex, iNewIndex1))
+                for (int i = 0; i < 3; ++i)
                 {
-                    iNewIndex1 = triNeighbour1.getIndex();
-                }
-            }
-
-            // Handle the opposite side of the triangle if necessary
-            if (iOldNeighbour > -1)
-            {
-                createTrianglesOppositeSide(iOldNeighbour, iPointIndex, iTriangleIndex, iNewIndex1);
-            }
-        }
-
-        // Handle case where the point is on Edge 1 (pt1 to pt2)
-        else if (triCurrent.onEdge(ptTargetPoint) == 1)
-        {
-            // Set points for the new triangle and update indices
-            triNewTriangle1.setPoint(0, triCurrent.getPoint(0));
-            triNewTriangle1.setPoint(1, triCurrent.getPoint(1));
-            triNewTriangle1.setPoint(2, ptTargetPoint);
-
-            triNewTriangle1.setPointIndex(0, triCurrent.getPointIndex(0));
-            triNewTriangle1.setPointIndex(1, triCurrent.getPointIndex(1));
-            triNewTriangle1.setPointIndex(2, iPointIndex);
-
-            // Set neighbor relationships for the new triangle
-            triNewTriangle1.setNeighbourIndex(0, triCurrent.getNeighbourIndex(0));
-            triNewTriangle1.setNeighbourIndex(2, iTriangleIndex);
+                    const Triangle& triCurrent = vecTriangles[iCurrentIndex];
+                    int iNeighbourIndex = triCurrent.getNeighbourIndex(i);
 
-            int iOldNeighbourIndex1 = triCurrent.getNeighbourIndex(0);
+                    if (iNeighbourIndex != -1 && inCavity(iNeighbourIndex))
+                    {
+                        continue;  // Interior edge of the cavity
+                    }
 
-            // Update the old neighbor to reference the new triangle
-            if (iOldNeighbourIndex1 != -1)
-            {
-                Triangle& triOldNeighbour = vecTriangles[iOldNeighbourIndex1];
-                for (int i = 0; i < 3; ++i)
-                {
-                    if (triOldNeighbour.getNeighbourIndex(i) == iTriangleIndex)
+                    if (iNeighbourIndex != -1 && vecTriangleMarks[iNeighbourIndex] == uConflictEpoch)
                     {
-                        triOldNeighbour.setNeighbourIndex(i, iNewIndex1);
-                        break;
+                        vecCavity.push_back(iNeighbourIndex);
+                        vecTriangleMarks[iNeighbourIndex] = uCavityEpoch;
+                        continue;
                     }
+
+                    CavityEdge edge;
+                    edge.iPointA = triCurrent.getPointIndex(i);
+                    edge.iPointB = triCurrent.getPointIndex((i + 1) % 3);
+                    edge.iOuterIndex = iNeighbourIndex;
+                    edge.iOuterEdge = iNeighbourIndex != -1 ? triCurrent.getNeighbourCorner(i) % 3 : -1;
+                    edge.iInnerIndex = iCurrentIndex;
+                    vecBoundary.push_back(edge);
                 }
             }
 
-            // Update the current triangle to include the new point
-            triCurrent.setPointIndex(1, iPointIndex);
-            triCurrent.setPoint(1, ptTargetPoint);
-            triCurrent.setNeighbourIndex(0, iNewIndex1);
-
-            const int iOldNeighbour = triCurrent.getNeighbourIndex(1);
-            triCurrent.setNeighbourIndex(1, -1);
-
-            // Add the new triangle to the list of triangles
-            vecTriangles.push_back(triNewTriangle1);
+            iWaveStart = iWaveEnd;
+        }
 
-            // Update references to the current and new triangles
-            triCurrent = vecTriangles[iTriangleIndex];
-            triNewTriangle1 = vecTriangles[iNewIndex1];
+        // Every boundary edge must be visible from the point, otherwise its star triangle would be inverted.
+        // A mesh that is not exactly Delaunay can leave such an edge behind; absorb the triangle beyond it and grow again.
+        for (const CavityEdge& edge : vecBoundary)
+        {
+            const Point& ptA = vecPtShape[edge.iPointA];
+            const Point& ptB = vecPtShape[edge.iPointB];
 
-            // Check and handle circumcircles for possible swaps
-            const Triangle& triNeighbour0 = vecTriangles[triCurrent.getNeighbourIndex(2)];
-            const Triangle& triNeighbour1 = vecTriangles[triNewTriangle1.getNeighbourIndex(0)];
+            double dCross = orient2d(ptA, ptB, ptTargetPoint);
 
-            if (triNeighbour0.isInCircumcircle(ptTargetPoint))
+            if (dCross <= 0 && edge.iOuterIndex != -1 && !inCavity(edge.iOuterIndex))
             {
-                std::queue<int> neighbourQueue = checkNeighboringCircumcircles(iTriangleIndex, iPointIndex, 2);
-                swapAll(neighbourQueue, iPointIndex);
-
-                if (areNeighbours(iTriangleIndex, iNewIndex1))
-                {
-                    iTriangleIndex = triNeighbour0.getIndex();
-                }
+                vecCavity.push_back(edge.iOuterIndex);
+                vecTriangleMarks[edge.iOuterIndex] = uCavityEpoch;
+                bGrown = true;
             }
+        }
+    }
 
-            if (triNeighbour1.isInCircumcircle(ptTargetPoint))
-            {
-                std::queue<int> neighbourQueue = checkNeighboringCircumcircles(iNewIndex1, iPointIndex, 0);
-                swapAll(neighbourQueue, iPointIndex);
+    // A cavity without interior points has exactly two boundary edges more than triangles;
+    // anything else means the cavity is not a topological disk, so use the split-and-flip engine instead
+    if (vecBoundary.size() != vecCavity.size() + 2)
+    {
+        createTriangles(iTriangleIndex, iPointIndex);
+        return;
+    }
 
-                if (areNeighbours(iTriangleIndex, iNewIndex1))
-                {
-                    iNewIndex1 = triNeighbour1.getIndex();
-                }
-            }
+    // Drop a boundary edge that the point lies on (point on the hull): its star triangle would be flat
+    std::vector<CavityEdge>& vecStar = vecStarScratch;
+    vecStar.clear();
+    for (CavityEdge& edge : vecBoundary)
+    {
+        const Point& ptA = vecPtShape[edge.iPointA];
+        const Point& ptB = vecPtShape[edge.iPointB];
 
-            // Handle the opposite side of the triangle if necessary
-            if (iOldNeighbour > -1)
-            {
-                createTrianglesOppositeSide(iOldNeighbour, iPointIndex, iTriangleIndex, iNewIndex1);
-            }
-        }
+        double dCross = orient2d(ptA, ptB, ptTargetPoint);
 
-        // Handle case where the point is on Edge 2 (pt2 to pt0)
-        else
+        if (dCross <= 0)
         {
-            // Set points for the new triangle and update indices
-            triNewTriangle1.setPoint(0, triCurrent.getPoint(1));
-            triNewTriangle1.setPoint(1, triCurrent.getPoint(2));
-            triNewTriangle1.setPoint(2, ptTargetPoint);
+            continue;
+        }
+
+        vecStar.push_back(edge);
+    }
 
-            triNewTriangle1.setPointIndex(0, triCurrent.getPointIndex(1));
-            triNewTriangle1.setPointIndex(1, triCurrent.getPointIndex(2));
-            triNewTriangle1.setPointIndex(2, iPointIndex);
+    if (vecStar.size() < vecCavity.size())
+    {
+        createTriangles(iTriangleIndex, iPointIndex);
+        return;
+    }
 
-            // Set neighbor relationships for the new triangle
-            triNewTriangle1.setNeighbourIndex(0, triCurrent.getNeighbourIndex(1));
-            triNewTriangle1.setNeighbourIndex(2, iTriangleIndex);
+    // Assign a slot to every star triangle, recycling the cavity slots first, then the free slots
+    std::vector<int>& vecSlots = vecSlotScratch;
+    vecSlots.assign(vecCavity.begin(), vecCavity.end());
+    while (vecSlots.size() < vecStar.size())
+    {
+        vecSlots.push_back(allocateTriangleSlot());
+    }
 
-            int iOldNeighbourIndex1 = triCurrent.getNeighbourIndex(1);
+    fillCavity(vecStar, vecSlots, iPointIndex, vecStarOrderScratch);
 
-            // Update the old neighbor to reference the new triangle
-            if (iOldNeighbourIndex1 != -1)
-            {
-                Triangle& triOldNeighbour = vecTriangles[iOldNeighbourIndex1];
-                for (int i = 0; i < 3; ++i)
-                {
-                    if (triOldNeighbour.getNeighbourIndex(i) == iTriangleIndex)
-                    {
-                        triOldNeighbour.setNeighbourIndex(i, iNewIndex1);
-                        break;
-                    }
-                }
-            }
+    for (int iSlot : vecSlots)
+    {
+        onTriangleChanged(iSlot);
+    }
+}
 
-            // Update the current triangle to include the new point
-            triCurrent.setPointIndex(2, iPointIndex);
-            triCurrent.setPoint(2, ptTargetPoint);
-            triCurrent.setNeighbourIndex(1, iNewIndex1);
+// Reserves iCount consecutive mark epochs. The marks are sized to the capacity of the triangle vector, so they only
+// grow with it. The 64-bit counter does not wrap, so the marks placed by earlier epochs are never erased.
+unsigned long long Mesh::nextMarkEpochs(unsigned int iCount)
+{
+    if (vecTriangleMarks.size() < vecTriangles.size())
+    {
+        vecTriangleMarks.resize(vecTriangles.capacity(), 0);
+    }
 
-            const int iOldNeighbour = triCurrent.getNeighbourIndex(2);
-            triCurrent.setNeighbourIndex(2, -1);
+    const unsigned long long uFirst = uMarkEpoch + 1;
+    uMarkEpoch += iCount;
+    return uFirst;
+}
 
-            // Add the new triangle to the list of triangles
-            vecTriangles.push_back(triNewTriangle1);
+// Retriangulates a cavity as a star around a point: the j-th star triangle (A, B, P) of the boundary edge vecStar[j] goes into
+// slot vecSlots[j] and is linked with the triangle outside the edge and with its neighbours in the fan. Only the star slots and
+// the outer triangles of the boundary are written, and the acceleration structures are left to the caller.
+void Mesh::fillCavity(const std::vector<CavityEdge>& vecStar, const std::vector<int>& vecSlots, int iPointIndex, std::vector<int>& vecOrder)
+{
+    // Sort the star triangles by their first point so neighbours around the new point can be found quickly
+    vecOrder.resize(vecStar.size());
+    for (int i = 0; i < vecOrder.size(); ++i)
+    {
+        vecOrder[i] = i;
+    }
+    std::sort(vecOrder.begin(), vecOrder.end(), [&vecStar](int iA, int iB) {
+        return vecStar[iA].iPointA < vecStar[iB].iPointA;
+    });
+
+    // Finds the slot of the star triangle whose first point is iPointA (-1 if there is none)
+    auto findStarSlot = [&](int iPointA) {
+        auto it = std::lower_bound(vecOrder.begin(), vecOrder.end(), iPointA, [&vecStar](int iStar, int iValue) {
+            return vecStar[iStar].iPointA < iValue;
+        });
+        return (it != vecOrder.end() && vecStar[*it].iPointA == iPointA) ? vecSlots[*it] : -1;
+    };
 
-            // Update references to the current and new triangles
-            triCurrent = vecTriangles[iTriangleIndex];
-            triNewTriangle1 = vecTriangles[iNewIndex1];
+    // Retriangulate the cavity as a star (A, B, P) around the new point
+    for (int j = 0; j < vecStar.size(); ++j)
+    {
+        const CavityEdge& edge = vecStar[j];
+        const int iSlot = vecSlots[j];
 
-            // Check and handle circumcircles for possible swaps
-            const Triangle& triNeighbour0 = vecTriangles[triCurrent.getNeighbourIndex(0)];
-            const Triangle& triNeighbour1 = vecTriangles[triNewTriangle1.getNeighbourIndex(0)];
+        Triangle triNewTriangle;
+        triNewTriangle.setIndex(iSlot);
 
-            if (triNeighbour0.isInCircumcircle(ptTargetPoint))
-            {
-                std::queue<int> neighbourQueue = checkNeighboringCircumcircles(iTriangleIndex, iPointIndex, 0);
-                swapAll(neighbourQueue, iPointIndex);
+        triNewTriangle.setPoint(0, vecPtShape[edge.iPointA]);
+        triNewTriangle.setPoint(1, vecPtShape[edge.iPointB]);
+        triNewTriangle.setPoint(2, vecPtShape[iPointIndex]);
 
-                if (areNeighbours(iTriangleIndex, iNewIndex1))
-                {
-                    iTriangleIndex = triNeighbour0.getIndex();
-                }
-            }
+        triNewTriangle.setPointIndex(0, edge.iPointA);
+        triNewTriangle.setPointIndex(1, edge.iPointB);
+        triNewTriangle.setPointIndex(2, iPointIndex);
 
-            if (triNeighbour1.isInCircumcircle(ptTargetPoint))
-            {
-                std::queue<int> neighbourQueue = checkNeighboringCircumcircles(iNewIndex1, iPointIndex, 0);
-                swapAll(neighbourQueue, iPointIndex);
+        vecTriangles[iSlot] = triNewTriangle;
 
-                if (areNeighbours(iTriangleIndex, iNewIndex1))
-                {
-                    iNewIndex1 = triNeighbour1.getIndex();
-                }
-            }
+        // Edge 0 faces the outside of the cavity, edges 1 and 2 the neighbouring star triangles
+        linkNeighbours(iSlot, 0, edge.iOuterIndex != -1 ? 3 * edge.iOuterIndex + edge.iOuterEdge : -1);
+    }
 
-            // Handle the opposite side of the triangle if necessary
-            if (iOldNeighbour > -1)
-            {
-                createTrianglesOppositeSide(iOldNeighbour, iPointIndex, iTriangleIndex, iNewIndex1);
-            }
-        }
+    // Close the fan: the star triangle after (A, B, P) is the one starting at B, so its edge 2 faces edge 1
+    for (int j = 0; j < vecStar.size(); ++j)
+    {
+        int iNextSlot = findStarSlot(vecStar[j].iPointB);
+        linkNeighbours(vecSlots[j], 1, iNextSlot != -1 ? 3 * iNextSlot + 2 : -1);
     }
 }
 
-// Creates new triangles on the opposite side of a specified triangle and point.
-void Mesh::createTrianglesOppositeSide(int iTriangleIndex, int iPointIndex, int iNeighbourIndex0, int iNeighbourIndex1)
+// Creates new triangles by splitting an existing triangle based on the provided point index.
+// The triangle (p0, p1, p2) becomes (p0, P, p2) and the two new triangles are (p0, p1, P) and (p1, p2, P);
+// the three edges facing away from P are then legalized.
+void Mesh::createTriangles(int iTriangleIndex, int iPointIndex)
 {
-    // Retrieve the point that will be used to create new triangles
-    const Point& ptTargetPoint = vecPtShape[iPointIndex];
-
-    // Get the current triangle that will be modified
-    Triangle& triCurrent = vecTriangles[iTriangleIndex];
-
-    // Create a new triangle to be added to the mesh
-    Triangle triNewTriangle1;
-    int iNewIndex1 = vecTriangles.size();
-    triNewTriangle1.setIndex(iNewIndex1);
+    // Validate indices to ensure they are within bounds
+    if (iTriangleIndex < 0 || iTriangleIndex >= vecTriangles.size() || iPointIndex < 0 || iPointIndex >= vecPtShape.size()) {
+        std::cerr << "Invalid indices provided to createTriangles." << std::endl;
+        return;
+    }
 
-    // Handle the case where the target point is on Edge 0 (between points 1 and 2)
-    if (triCurrent.onEdge(ptTargetPoint) == 0)
+    // Handle cases where the target point lies on an edge of the current triangle
+    if (vecTriangles[iTriangleIndex].onEdge(vecPtShape[iPointIndex]) >= 0)
     {
-        // Define the points of the new triangle
-        triNewTriangle1.setPoint(0, triCurrent.getPoint(1));
-        triNewTriangle1.setPoint(1, triCurrent.getPoint(2));
-        triNewTriangle1.setPoint(2, ptTargetPoint);
-
-        // Set the point indices for the new triangle
-        triNewTriangle1.setPointIndex(0, triCurrent.getPointIndex(1));
-        triNewTriangle1.setPointIndex(1, triCurrent.getPointIndex(2));
-        triNewTriangle1.setPointIndex(2, iPointIndex);
+        handleEdgeCase(iTriangleIndex, iPointIndex);
+        return;
+    }
 
-        // Set the neighbors of the new triangle
-        triNewTriangle1.setNeighbourIndex(1, iTriangleIndex);
-        triNewTriangle1.setNeighbourIndex(0, triCurrent.getNeighbourIndex(1));
+    const Triangle triCurrent = vecTriangles[iTriangleIndex];
+    const int iPoint0 = triCurrent.getPointIndex(0);
+    const int iPoint1 = triCurrent.getPointIndex(1);
+    const int iPoint2 = triCurrent.getPointIndex(2);
+
+    // Outer corners of the edges p0->p1 and p1->p2 move to the new triangles
+    const int iOuterCorner0 = triCurrent.getNeighbourCorner(0);
+    const int iOuterCorner1 = triCurrent.getNeighbourCorner(1);
+    const int iOuterCorner2 = triCurrent.getNeighbourCorner(2);
+
+    const int iNewIndex1 = allocateTriangleSlot();
+    const int iNewIndex2 = allocateTriangleSlot();
+
+    vecTriangles[iTriangleIndex] = makeTriangle(iTriangleIndex, iPoint0, iPointIndex, iPoint2);
+    vecTriangles[iNewIndex1] = makeTriangle(iNewIndex1, iPoint0, iPoint1, iPointIndex);
+    vecTriangles[iNewIndex2] = makeTriangle(iNewIndex2, iPoint1, iPoint2, iPointIndex);
+
+    linkNeighbours(iTriangleIndex, 0, 3 * iNewIndex1 + 2);
+    linkNeighbours(iTriangleIndex, 1, 3 * iNewIndex2 + 1);
+    linkNeighbours(iTriangleIndex, 2, iOuterCorner2);
+    linkNeighbours(iNewIndex1, 0, iOuterCorner0);
+    linkNeighbours(iNewIndex1, 1, 3 * iNewIndex2 + 2);
+    linkNeighbours(iNewIndex2, 0, iOuterCorner1);
+
+    onTriangleChanged(iTriangleIndex);
+    onTriangleChanged(iNewIndex1);
+    onTriangleChanged(iNewIndex2);
+
+    // Check the edges opposite the new point and swap them if necessary to maintain the Delaunay condition
+    vecLegalizeStack.push_back(3 * iTriangleIndex + 2);
+    vecLegalizeStack.push_back(3 * iNewIndex1);
+    vecLegalizeStack.push_back(3 * iNewIndex2);
+    legalizeEdges(iPointIndex);
+}
 
-        // Update the neighbor index of the old neighbor
-        int iOldNeighbourIndex1 = triCurrent.getNeighbourIndex(1);
-        if (iOldNeighbourIndex1 != -1)
-        {
-            Triangle& triOldNeighbour = vecTriangles[iOldNeighbourIndex1];
-            for (int i = 0; i < 3; ++i)
-            {
-                if (triOldNeighbour.getNeighbourIndex(i) == iTriangleIndex)
-                {
-                    triOldNeighbour.setNeighbourIndex(i, iNewIndex1);
-                    break;
-                }
-            }
-        }
+// Handles the case of a point lying on an edge of the triangle that contains it.
+// With the triangle (a, b, c) and the point P on a->b, the triangle becomes (c, a, P) and (b, c, P) is added;
+// the neighbour (b, a, d) across the edge, if any, becomes (a, d, P) and (d, b, P) is added.
+void Mesh::handleEdgeCase(int iTriangleIndex, int iPointIndex)
+{
+    const Triangle triCurrent = vecTriangles[iTriangleIndex];
+    const int iEdge = triCurrent.onEdge(vecPtShape[iPointIndex]);
+    if (iEdge < 0)
+    {
+        return;
+    }
 
-        // Update the current triangle with the new point and neighbor
-        triCurrent.setPointIndex(1, iPointIndex);
-        triCurrent.setPoint(1, ptTargetPoint);
-        triCurrent.setNeighbourIndex(1, iNewIndex1);
+    const int iPointA = triCurrent.getPointIndex(iEdge);
+    const int iPointB = triCurrent.getPointIndex((iEdge + 1) % 3);
+    const int iPointC = triCurrent.getPointIndex((iEdge + 2) % 3);
 
-        // Determine the appropriate neighbor indices for the new triangle
-        if (areNeighbours(iTriangleIndex, iNeighbourIndex0))
-        {
-            triNewTriangle1.setNeighbourIndex(2, iNeighbourIndex1);
-            triCurrent.setNeighbourIndex(0, iNeighbourIndex0);
-        }
-        else
-        {
-            triNewTriangle1.setNeighbourIndex(2, iNeighbourIndex0);
-            triCurrent.setNeighbourIndex(0, iNeighbourIndex1);
-        }
+    const int iCornerBC = triCurrent.getNeighbourCorner((iEdge + 1) % 3);
+    const int iCornerCA = triCurrent.getNeighbourCorner((iEdge + 2) % 3);
+    const int iOppositeCorner = triCurrent.getNeighbourCorner(iEdge);
 
-        // Add the new triangle to the list of triangles
-        vecTriangles.push_back(triNewTriangle1);
+    const int iNewIndex1 = allocateTriangleSlot();
+    vecTriangles[iTriangleIndex] = makeTriangle(iTriangleIndex, iPointC, iPointA, iPointIndex);
+    vecTriangles[iNewIndex1] = makeTriangle(iNewIndex1, iPointB, iPointC, iPointIndex);
+    counters.add(MeshCounter::EdgeCaseSplits);
 
-        // Update the reference to the current triangle and perform edge neighbor updates
-        triCurrent = vecTriangles[iTriangleIndex];
-        updateEdgeNeighbours(iTriangleIndex, iNewIndex1, iNeighbourIndex0, iNeighbourIndex1);
+    linkNeighbours(iTriangleIndex, 0, iCornerCA);
+    linkNeighbours(iTriangleIndex, 2, 3 * iNewIndex1 + 1);
+    linkNeighbours(iNewIndex1, 0, iCornerBC);
 
-        // Check if the new triangles' neighbors are in the circumcircle of the target point
-        const Triangle& triNeighbour0 = vecTriangles[triCurrent.getNeighbourIndex(2)];
-        const Triangle& triNeighbour1 = vecTriangles[triNewTriangle1.getNeighbourIndex(0)];
-        if (triNeighbour0.isInCircumcircle(ptTargetPoint))
-        {
-            std::queue<int> neighbourQueue = checkNeighboringCircumcircles(iTriangleIndex, iPointIndex, 2);
-            swapAll(neighbourQueue, iPointIndex);
-        }
+    onTriangleChanged(iTriangleIndex);
+    onTriangleChanged(iNewIndex1);
 
-        if (triNeighbour1.isInCircumcircle(ptTargetPoint))
-        {
-            std::queue<int> neighbourQueue = checkNeighboringCircumcircles(iNewIndex1, iPointIndex, 0);
-            swapAll(neighbourQueue, iPointIndex);
-        }
+    vecLegalizeStack.push_back(3 * iTriangleIndex);
+    vecLegalizeStack.push_back(3 * iNewIndex1);
+
+    if (iOppositeCorner == -1)
+    {
+        // The edge is on the border of the mesh
+        linkNeighbours(iTriangleIndex, 1, -1);
+        linkNeighbours(iNewIndex1, 2, -1);
     }
-    // Handle the case where the target point is on Edge 1 (between points 0 and 1)
-    else if (triCurrent.onEdge(ptTargetPoint) == 1)
+    else
     {
-        // Define the points of the new triangle
-        triNewTriangle1.setPoint(0, triCurrent.getPoint(0));
-        triNewTriangle1.setPoint(1, triCurrent.getPoint(1));
-        triNewTriangle1.setPoint(2, ptTargetPoint);
+        // Split the neighbour across the edge as well
+        const int iOppositeIndex = iOppositeCorner / 3;
+        const int iOppositeEdge = iOppositeCorner % 3;
+        const Triangle triOpposite = vecTriangles[iOppositeIndex];
+
+        const int iPointD = triOpposite.getPointIndex((iOppositeEdge + 2) % 3);
+        const int iCornerAD = triOpposite.getNeighbourCorner((iOppositeEdge + 1) % 3);
+        const int iCornerDB = triOpposite.getNeighbourCorner((iOppositeEdge + 2) % 3);
+
+        const int iNewIndex2 = allocateTriangleSlot();
+        vecTriangles[iOppositeIndex] = makeTriangle(iOppositeIndex, iPointA, iPointD, iPointIndex);
+        vecTriangles[iNewIndex2] = makeTriangle(iNewIndex2, iPointD, iPointB, iPointIndex);
+
+        linkNeighbours(iOppositeIndex, 0, iCornerAD);
+        linkNeighbours(iOppositeIndex, 1, 3 * iNewIndex2 + 2);
+        linkNeighbours(iOppositeIndex, 2, 3 * iTriangleIndex + 1);
+        linkNeighbours(iNewIndex2, 0, iCornerDB);
+        linkNeighbours(iNewIndex2, 1, 3 * iNewIndex1 + 2);
+
+        onTriangleChanged(iOppositeIndex);
+        onTriangleChanged(iNewIndex2);
+
+        vecLegalizeStack.push_back(3 * iOppositeIndex);
+        vecLegalizeStack.push_back(3 * iNewIndex2);
+    }
 
-        // Set the point indices for the new triangle
-        triNewTriangle1.setPointIndex(0, triCurrent.getPointIndex(0));
-        triNewTriangle1.setPointIndex(1, triCurrent.getPointIndex(1));
-        triNewTriangle1.setPointIndex(2, iPointIndex);
+    legalizeEdges(iPointIndex);
+}
 
-        // Set the neighbors of the new triangle
-        triNewTriangle1.setNeighbourIndex(0, triCurrent.getNeighbourIndex(0));
-        triNewTriangle1.setNeighbourIndex(2, iTriangleIndex);
+// Builds a triangle from three point indices, without neighbours.
+Triangle Mesh::makeTriangle(int iTriangleIndex, int iPointA, int iPointB, int iPointC) const
+{
+    Triangle triangle;
+    triangle.setIndex(iTriangleIndex);
 
-        // Update the neighbor index of the old neighbor
-        int iOldNeighbourIndex1 = triCurrent.getNeighbourIndex(0);
-        if (iOldNeighbourIndex1 != -1)
-        {
-            Triangle& triOldNeighbour = vecTriangles[iOldNeighbourIndex1];
-            for (int i = 0; i < 3; ++i)
-            {
-                if (triOldNeighbour.getNeighbourIndex(i) == iTriangleIndex)
-                {
-                    triOldNeighbour.setNeighbourIndex(i, iNewIndex1);
-                    break;
-                }
-            }
-        }
+    triangle.setPoint(0, vecPtShape[iPointA]);
+    triangle.setPoint(1, vecPtShape[iPointB]);
+    triangle.setPoint(2, vecPtShape[iPointC]);
 
-        // Update the current triangle with the new point and neighbor
-        triCurrent.setPointIndex(1, iPointIndex);
-        triCurrent.setPoint(1, ptTargetPoint);
-        triCurrent.setNeighbourIndex(0, iNewIndex1);
+    triangle.setPointIndex(0, iPointA);
+    triangle.setPointIndex(1, iPointB);
+    triangle.setPointIndex(2, iPointC);
 
-        // Determine the appropriate neighbor indices for the new triangle
-        if (areNeighbours(iTriangleIndex, iNeighbourIndex1))
-        {
-            triNewTriangle1.setNeighbourIndex(1, iNeighbourIndex0);
-            triCurrent.setNeighbourIndex(1, iNeighbourIndex1);
-        }
-        else
-        {
-            triNewTriangle1.setNeighbourIndex(1, iNeighbourIndex1);
-            triCurrent.setNeighbourIndex(1, iNeighbourIndex0);
-        }
+    return triangle;
+}
 
-        // Add the new triangle to the list of triangles
-        vecTriangles.push_back(triNewTriangle1);
+// Links an edge of a triangle with an encoded neighbour corner and points the neighbour back at the edge.
+void Mesh::linkNeighbours(int iTriangleIndex, int iEdge, int iCorner)
+{
+    vecTriangles[iTriangleIndex].setNeighbourCorner(iEdge, iCorner);
 
-        // Update the reference to the current triangle and perform edge neighbor updates
-        triCurrent = vecTriangles[iTriangleIndex];
-        updateEdgeNeighbours(iTriangleIndex, iNewIndex1, iNeighbourIndex0, iNeighbourIndex1);
+    if (iCorner != -1)
+    {
+        vecTriangles[iCorner / 3].setNeighbourCorner(iCorner % 3, 3 * iTriangleIndex + iEdge);
 
-        // Check if the new triangles' neighbors are in the circumcircle of the target point
-        const Triangle& triNeighbour0 = vecTriangles[triCurrent.getNeighbourIndex(2)];
-        const Triangle& triNeighbour1 = vecTriangles[triNewTriangle1.getNeighbourIndex(0)];
-        if (triNeighbour0.isInCircumcircle(ptTargetPoint))
+        // The neighbour keeps its shape, but callers of insertPoints still need to know that its links changed
+        if (bTrackRelinkedTriangles)
         {
-            std::queue<int> neighbourQueue = checkNeighboringCircumcircles(iTriangleIndex, iPointIndex, 2);
-            swapAll(neighbourQueue, iPointIndex);
+            vecChangedTriangles.push_back(iCorner / 3);
         }
+    }
+}
 
-        if (triNeighbour1.isInCircumcircle(ptTargetPoint))
+// Rebuilds the encoded neighbour corners from the neighbour indices and the point indices of the triangles.
+void Mesh::resolveNeighbourCorners()
+{
+    vecFreeTriangleSlots.clear();
+    bVertexTrianglesComplete = false;
+    for (Triangle& triangle : vecTriangles)
+    {
+        // Free slots (e.g. in triangles taken back from release) are collected for reuse
+        if (triangle.isFree())
         {
-            std::queue<int> neighbourQueue = checkNeighboringCircumcircles(iNewIndex1, iPointIndex, 0);
-            swapAll(neighbourQueue, iPointIndex);
+            vecFreeTriangleSlots.push_back(triangle.getIndex());
+            continue;
         }
-    }
-    // Handle the case where the target point is on Edge 2 (between points 1 and 2)
-    else
-    {
-        // Define the points of the new triangle
-        triNewTriangle1.setPoint(0, triCurrent.getPoint(1));
-        triNewTriangle1.setPoint(1, triCurrent.getPoint(2));
-        triNewTriangle1.setPoint(2, ptTargetPoint);
-
-        // Set the point indices for the new triangle
-        triNewTriangle1.setPointIndex(0, triCurrent.getPointIndex(1));
-        triNewTriangle1.setPointIndex(1, triCurrent.getPointIndex(2));
-        triNewTriangle1.setPointIndex(2, iPointIndex);
 
-        // Set the neighbors of the new triangle
-        triNewTriangle1.setNeighbourIndex(0, triCurrent.getNeighbourIndex(1));
-        triNewTriangle1.setNeighbourIndex(2, iTriangleIndex);
-
-        // Update the neighbor index of the old neighbor
-        int iOldNeighbourIndex1 = triCurrent.getNeighbourIndex(1);
-        if (iOldNeighbourIndex1 != -1)
+        for (int i = 0; i < 3; ++i)
         {
-            Triangle& triOldNeighbour = vecTriangles[iOldNeighbourIndex1];
-            for (int i = 0; i < 3; ++i)
+            int iNeighbourIndex = triangle.getNeighbourIndex(i);
+            if (iNeighbourIndex < 0 || iNeighbourIndex >= vecTriangles.size())
             {
-                if (triOldNeighbour.getNeighbourIndex(i) == iTriangleIndex)
+                triangle.setNeighbourCorner(i, -1);
+                continue;
+            }
+
+            // The neighbour runs along the same edge in the opposite direction
+            const Triangle& triNeighbour = vecTriangles[iNeighbourIndex];
+            for (int j = 0; j < 3; ++j)
+            {
+                if (triNeighbour.getPointIndex(j) == triangle.getPointIndex((i + 1) % 3) &&
+                    triNeighbour.getPointIndex((j + 1) % 3) == triangle.getPointIndex(i))
                 {
-                    triOldNeighbour.setNeighbourIndex(i, iNewIndex1);
+                    triangle.setNeighbourCorner(i, 3 * iNeighbourIndex + j);
                     break;
                 }
             }
         }
+    }
+}
 
-        // Update the current triangle with the new point and neighbor
-        triCurrent.setPointIndex(2, iPointIndex);
-        triCurrent.setPoint(2, ptTargetPoint);
-        triCurrent.setNeighbourIndex(1, iNewIndex1);
-
-        // Determine the appropriate neighbor indices for the new triangle
-        if (areNeighbours(iTriangleIndex, iNeighbourIndex0))
-        {
-            triNewTriangle1.setNeighbourIndex(1, iNeighbourIndex1);
-            triCurrent.setNeighbourIndex(2, iNeighbourIndex0);
-        }
-        else
-        {
-            triNewTriangle1.setNeighbourIndex(1, iNeighbourIndex0);
-            triCurrent.setNeighbourIndex(2, iNeighbourIndex1);
-        }
-
-        // Add the new triangle to the list of triangles
-        vecTriangles.push_back(triNewTriangle1);
-
-        // Update the reference to the current triangle and perform edge neighbor updates
-        triCurrent = vecTriangles[iTriangleIndex];
-        updateEdgeNeighbours(iTriangleIndex, iNewIndex1, iNeighbourIndex0, iNeighbourIndex1);
-
-        // Check if the new triangles' neighbors are in the circumcircle of the target point
-        const Triangle& triNeighbour0 = vecTriangles[triCurrent.getNeighbourIndex(0)];
-        const Triangle& triNeighbour1 = vecTriangles[triNewTriangle1.getNeighbourIndex(0)];
-        if (triNeighbour0.isInCircumcircle(ptTargetPoint))
-        {
-            std::queue<int> neighbourQueue = checkNeighboringCircumcircles(iTriangleIndex, iPointIndex, 0);
-            swapAll(neighbourQueue, iPointIndex);
-        }
+// Swaps the edge between two neighbouring triangles.
+void Mesh::swapEdge(int iTri1, int iTri2)
+{
+    const Triangle& triCurrent = vecTriangles[iTri1];
 
-        if (triNeighbour1.isInCircumcircle(ptTargetPoint))
+    for (int i = 0; i < 3; ++i)
+    {
+        if (triCurrent.getNeighbourIndex(i) == iTri2)
         {
-            std::queue<int> neighbourQueue = checkNeighboringCircumcircles(iNewIndex1, iPointIndex, 0);
-            swapAll(neighbourQueue, iPointIndex);
+            flipEdge(iTri1, i);
+            return;
         }
     }
 }
 
-// Updates the neighboring triangles' edge references after swapping edges.
-void Mesh::updateEdgeNeighbours(int iTriangleIndex, int iNewTriangleIndex, int iNeighbourIndex0, int iNeighbourIndex1)
+// Flips the edge across edge iEdge of a triangle.
+// With the triangle (a, b, c) and the neighbour (b, a, d) across a->b, the triangle becomes (c, a, d) and the
+// neighbour (d, b, c). The four outer corners are relinked directly, so no searching is needed.
+void Mesh::flipEdge(int iTriangleIndex, int iEdge)
 {
-    // Swap neighbor indices if necessary to maintain consistency
-    if (areNeighbours(iTriangleIndex, iNeighbourIndex0))
+    const Triangle triCurrent = vecTriangles[iTriangleIndex];
+    const int iNeighbourCorner = triCurrent.getNeighbourCorner(iEdge);
+    if (iNeighbourCorner == -1)
     {
-        std::swap(iNeighbourIndex0, iNeighbourIndex1);
+        return;
     }
 
-    // Retrieve the triangles based on their indices
-    Triangle& triCurrent = vecTriangles[iTriangleIndex];
-    Triangle& triNewTriangle = vecTriangles[iNewTriangleIndex];
-
-    Triangle& triOldNeighbour0 = vecTriangles[iNeighbourIndex0];
-    Triangle& triOldNeighbour1 = vecTriangles[iNeighbourIndex1];
+    const int iNeighbourIndex = iNeighbourCorner / 3;
+    const int iNeighbourEdge = iNeighbourCorner % 3;
+    const Triangle triNeighbour = vecTriangles[iNeighbourIndex];
+
+    const int iPointA = triCurrent.getPointIndex(iEdge);
+    const int iPointB = triCurrent.getPointIndex((iEdge + 1) % 3);
+    const int iPointC = triCurrent.getPointIndex((iEdge + 2) % 3);
+    const int iPointD = triNeighbour.getPointIndex((iNeighbourEdge + 2) % 3);
+
+    const int iCornerBC = triCurrent.getNeighbourCorner((iEdge + 1) % 3);
+    const int iCornerCA = triCurrent.getNeighbourCorner((iEdge + 2) % 3);
+    const int iCornerAD = triNeighbour.getNeighbourCorner((iNeighbourEdge + 1) % 3);
+    const int iCornerDB = triNeighbour.getNeighbourCorner((iNeighbourEdge + 2) % 3);
+
+    vecTriangles[iTriangleIndex] = makeTriangle(iTriangleIndex, iPointC, iPointA, iPointD);
+    vecTriangles[iNeighbourIndex] = makeTriangle(iNeighbourIndex, iPointD, iPointB, iPointC);
+
+    linkNeighbours(iTriangleIndex, 0, iCornerCA);
+    linkNeighbours(iTriangleIndex, 1, iCornerAD);
+    linkNeighbours(iTriangleIndex, 2, 3 * iNeighbourIndex + 2);
+    linkNeighbours(iNeighbourIndex, 0, iCornerDB);
+    linkNeighbours(iNeighbourIndex, 1, iCornerBC);
+    counters.add(MeshCounter::Flips);
+
+    // Both triangle slots were reused with new points
+    onTriangleChanged(iTriangleIndex);
+    onTriangleChanged(iNeighbourIndex);
+}
 
-    int iEdgeIndex0, iEdgeIndex1;
+// Restores the Delaunay property around a newly inserted point (Lawson's algorithm).
+// Every corner on the stack has the new point opposite its edge; when the point lies inside the circumcircle
+// of the triangle across that edge, the edge is flipped and the two edges that moved away from the point are
+// checked in turn.
+void Mesh::legalizeEdges(int iPointIndex)
+{
+    const Point& ptTargetPoint = vecPtShape[iPointIndex];
 
-    // Find the edge indices of the current and new triangles that correspond to the neighbor indices
-    for (int i = 0; i < 3; ++i)
+    while (!vecLegalizeStack.empty())
     {
-        if (triNewTriangle.getNeighbourIndex(i) == iNeighbourIndex0)
-        {
-            iEdgeIndex0 = i;
-        }
+        const int iCorner = vecLegalizeStack.back();
+        vecLegalizeStack.pop_back();
 
-        if (triCurrent.getNeighbourIndex(i) == iNeighbourIndex1)
+        const int iTriangleIndex = iCorner / 3;
+        const int iEdge = iCorner % 3;
+        const int iNeighbourIndex = vecTriangles[iTriangleIndex].getNeighbourIndex(iEdge);
+
+        if (iNeighbourIndex == -1 || !isInConflict(iNeighbourIndex, ptTargetPoint))
         {
-            iEdgeIndex1 = i;
+            continue;
         }
-    }
 
-    // Calculate the midpoints of the edges that connect the new triangle and current triangle
-    Point ptMid0 = triNewTriangle.getEdgeMidpoint(iEdgeIndex0);
-    Point ptMid1 = triCurrent.getEdgeMidpoint(iEdgeIndex1);
+        flipEdge(iTriangleIndex, iEdge);
+
+        vecLegalizeStack.push_back(3 * iTriangleIndex + 1);
+        vecLegalizeStack.push_back(3 * iNeighbourIndex);
+    }
+}
 
-    // Determine the target edge indices in the old neighbor triangles
-    int iTargetEdgeIndex0 = triOldNeighbour0.onEdge(ptMid0);
-    int iTargetEdgeIndex1 = triOldNeighbour1.onEdge(ptMid1);
+// Sets the maximum number of points the refinement may add (0 picks one from the triangle count)
+void Mesh::setRefinementPointLimit(int iLimit)
+{
+    iRefinementPointLimit = iLimit;
+}
 
-    // Update the neighbor indices in the old neighbor triangles
-    triOldNeighbour0.setNeighbourIndex(iTargetEdgeIndex0, iNewTriangleIndex);
-    triOldNeighbour1.setNeighbourIndex(iTargetEdgeIndex1, iTriangleIndex);
+// Returns the maximum number of points the refinement may add
+int Mesh::getRefinementPointLimit() const
+{
+    return iRefinementPointLimit;
 }
 
-// Determines if two triangles share an edge by checking their points.
-bool Mesh::areNeighbours(int iTri1, int iTri2)
+// Adjusts triangles to make them more equilateral by adding new points and creating new triangles.
+// The bad triangles are kept in a priority queue keyed by their smallest angle, filled once at the start.
+// After each insertion only the slots created or flipped are queued again; entries whose slot has changed
+// since they were queued are discarded when they reach the top.
+// Circumcenter insertion is not guaranteed to reach a 40 degree minimum angle, so the number of added
+// points is bounded by the refinement point limit.
+// With parallel refinement on more than one thread the queue is drained in conflict-free batches instead
+// (see refineBatch); both loops stop under the same conditions, so they leave no fixable bad triangle behind.
+void Mesh::equilateralizeTriangles()
 {
-    // Retrieve the triangles based on their indices
-    const Triangle& tri1 = vecTriangles[iTri1];
-    const Triangle& tri2 = vecTriangles[iTri2];
+    ScopedPhase phase(counters, MeshPhase::Refinement);
 
-    int iSharedCount = 0;  // Counter for shared points
+    const int iPointLimit = iRefinementPointLimit > 0 ? iRefinementPointLimit : REFINEMENT_POINTS_PER_TRIANGLE * static_cast<int>(vecTriangles.size());
+    int iPointsAdded = 0;
 
-    // Identify shared points between the two triangles
-    for (int i = 0; i < 3; ++i)
+    pqRefinement = {};
+    vecTriangleVersions.assign(vecTriangles.size(), 0);
+    vecChangedTriangles.clear();
+
+    queueAllRefinementCandidates();
+
+    bTrackChangedTriangles = true;
+
+    // The batches test conflicts without the super triangle, so a mesh that still has it is refined serially,
+    // as is any mesh when a single thread is requested. The workers are started once for all the batches.
+    const int iThreads = resolveThreadCount(iThreadCount);
+    const bool bParallel = bParallelRefinement && iSuperPointIndex < 0 && iThreads > 1;
+    WorkerPool pool(bParallel ? iThreads : 1);
+
+    // Continuously process triangles until no triangles with small angles are left or the point limit is reached
+    while (!pqRefinement.empty() && iPointsAdded < iPointLimit)
     {
-        for (int j = 0; j < 3; ++j)
+        if (bParallel)
         {
-            int pointCurrent = tri1.getPointIndex(i);
-            int pointNeighbour = tri2.getPointIndex(j);
+            iPointsAdded += refineBatch(pool, iPointLimit - iPointsAdded);
+            continue;
+        }
 
-            if (pointCurrent == pointNeighbour)
-            {
-                ++iSharedCount;  // Increment shared points count
-            }
+        const RefinementEntry entry = pqRefinement.top();
+        pqRefinement.pop();
+
+        // Skip entries of slots that were changed after they were queued
+        if (entry.uVersion != vecTriangleVersions[entry.iTriangleIndex])
+        {
+            continue;
         }
-    }
 
-    // Two triangles are considered neighbors if they share exactly two points
-    if (iSharedCount == 2)
-    {
-        return true;
-    }
-    else
-    {
-        return false;
+        if (refineTriangle(entry.iTriangleIndex))
+        {
+            ++iPointsAdded;
+            queueChangedTriangles();
+        }
     }
+
+    bTrackChangedTriangles = false;
 }
 
-// Checks neighboring triangles' circumcircles to find those containing the target point.
-std::queue<int> Mesh::checkNeighboringCircumcircles(int iTriangleIndex, int iPointIndex, int iEdgeIndex)
+// Inserts the circumcenter of a bad triangle and returns whether a point was added.
+// The slots changed by the insertion are left in vecChangedTriangles.
+bool Mesh::refineTriangle(int iTriangleIndex)
 {
-    // Initialize a queue to keep track of triangles to check
-    std::queue<int> neighbourQueue;
-    neighbourQueue.push(iTriangleIndex);
+    const Triangle& triangle = vecTriangles[iTriangleIndex];
 
-    // Vector to track visited triangles to avoid processing them multiple times
-    std::vector<bool> visited(vecTriangles.size(), false);
+    Point circumcenter = triangle.getCircumcenter();
 
-    const Point& ptTargetPoint = vecPtShape[iPointIndex];
-    size_t iQueueIndex = 0;
-    bool firstIteration = true;
+    // Find the triangle that contains the circumcenter, starting from the bad triangle
+    int containingTriangleIndex = findContainingTriangle(circumcenter, iTriangleIndex);
 
-    // Traverse the queue of triangles
-    while (iQueueIndex < neighbourQueue.size())
+    // Circumcenters outside the mesh cannot be inserted, so the triangle is left as it is
+    if (containingTriangleIndex == -1)
     {
-        int iCurrentIndex = neighbourQueue.back();
+        return false;
+    }
 
-        // Check if the current triangle has not been visited
-        // Add all triangles that contain the point in their circumcircle to the queue
-        if (!visited[iCurrentIndex])
+    // Nor can circumcenters that coincide with an existing point
+    const Triangle& triContaining = vecTriangles[containingTriangleIndex];
+    for (int j = 0; j < 3; ++j)
+    {
+        const Point ptCorner = triContaining.getPoint(j);
+        if (ptCorner.getX() == circumcenter.getX() && ptCorner.getY() == circumcenter.getY())
         {
-            visited[iCurrentIndex] = true;
-            Triangle& triCurrent = vecTriangles[iCurrentIndex];
-
-            // Check only specified edge for the first iteration
-            if (firstIteration)
-            {
-                int iNeighbourIndex = triCurrent.getNeighbourIndex(iEdgeIndex);
+            return false;
+        }
+    }
 
-                if (iNeighbourIndex >= 0 && !visited[iNeighbourIndex])
-                {
-                    Triangle& triNeighbour = vecTriangles[iNeighbourIndex];
+    vecPtShape.push_back(circumcenter);
 
-                    if (triNeighbour.isInCircumcircle(ptTargetPoint))
-                    {
-                        neighbourQueue.push(iNeighbourIndex);
-                    }
-                }
-                firstIteration = false;
-            }
-            else
-            {
-                // For subsequent triangles, check all three edges
-                for (int i = 0; i < 3; ++i)
-                {
-                    int iNeighbourIndex = triCurrent.getNeighbourIndex(i);
+    int newPointIndex = vecPtShape.size() - 1;
 
-                    if (iNeighbourIndex >= 0 && !visited[iNeighbourIndex])
-                    {
-                        Triangle& triNeighbour = vecTriangles[iNeighbourIndex];
+    // Create new triangles by connecting the new point with the containing triangle
+    insertPoint(containingTriangleIndex, newPointIndex);
+    return true;
+}
 
-                        if (triNeighbour.isInCircumcircle(ptTargetPoint))
-                        {
-                            neighbourQueue.push(iNeighbourIndex);
-                        }
-                    }
-                }
-            }
-        }
-        iQueueIndex++;
+// Queues the slots changed since the last call, once each, now that all of their neighbours are linked
+void Mesh::queueChangedTriangles()
+{
+    std::sort(vecChangedTriangles.begin(), vecChangedTriangles.end());
+    vecChangedTriangles.erase(std::unique(vecChangedTriangles.begin(), vecChangedTriangles.end()), vecChangedTriangles.end());
+    for (int iChangedIndex : vecChangedTriangles)
+    {
+        pushRefinementCandidate(iChangedIndex);
     }
-
-    // Return the queue containing all triangles whose circumcircles include the target point
-    return neighbourQueue;
+    vecChangedTriangles.clear();
 }
 
-// Swaps the edge between two triangles and updates their neighboring relationships.
-void Mesh::swapEdge(int iTri1, int iTri2)
+// Refines a batch of bad triangles concurrently and returns the number of points added (at most iMaxPoints).
+// The batch holds the best valid entries of the queue. The candidates are first analysed in parallel without
+// modifying the mesh, then accepted greedily in queue order as long as their cavity and the triangles around it
+// do not overlap those of a candidate accepted before. The accepted cavities are disjoint, so they are
+// retriangulated in parallel into point indices and slots assigned in acceptance order. Candidates rejected
+// for an overlap go back into the queue; those whose cavity is not a simple star are refined serially afterwards.
+// No step depends on the number of threads or on their timing, so every thread count produces the same mesh.
+int Mesh::refineBatch(WorkerPool& pool, int iMaxPoints)
 {
-    // Retrieve the triangles based on their indices
-    Triangle& triCurrent = vecTriangles[iTri1];
-    Triangle& triNeighbour = vecTriangles[iTri2];
-
-    int diff1 = -1, diff2 = -1;
-    std::vector<int> shared;
-
-    // Identify shared points between the two triangles
-    for (int i = 0; i < 3; ++i)
+    const int iThreads = pool.getThreadCount();
+
+    // Collect the best valid entries; the circumcenters are computed here since they fill the triangle caches.
+    // The candidates are kept from batch to batch so that their cavity buffers are reused.
+    std::vector<RefinementCandidate>& vecBatch = vecRefinementBatch;
+    vecBatch.resize(REFINEMENT_BATCH_SIZE);
+    int iBatchSize = 0;
+    while (!pqRefinement.empty() && iBatchSize < REFINEMENT_BATCH_SIZE)
     {
-        for (int j = 0; j < 3; ++j)
-        {
-            int pointCurrent = triCurrent.getPointIndex(i);
-            int pointNeighbour = triNeighbour.getPointIndex(j);
+        const RefinementEntry entry = pqRefinement.top();
+        pqRefinement.pop();
 
-            if (pointCurrent == pointNeighbour)
-            {
-                shared.push_back(pointCurrent); // Store shared points
-            }
+        if (entry.uVersion != vecTriangleVersions[entry.iTriangleIndex])
+        {
+            continue;
         }
-    }
 
-    // Identify the different points in each triangle
-    for (int i = 0; i < 3; ++i)
-    {
-        int pointCurrent = triCurrent.getPointIndex(i);
-        int pointNeighbour = triNeighbour.getPointIndex(i);
+        RefinementCandidate& candidate = vecBatch[iBatchSize++];
+        candidate.entry = entry;
+        candidate.ptCenter = vecTriangles[entry.iTriangleIndex].getCircumcenter();
+        candidate.vecCavity.clear();
+        candidate.vecStar.clear();
+    }
 
-        if (std::find(shared.begin(), shared.end(), pointCurrent) == shared.end())
+    pool.run(iBatchSize, std::max(1, std::min(iThreads, iBatchSize / MIN_PARALLEL_CANDIDATES)), [&](int iBegin, int iEnd, int) {
+        for (int k = iBegin; k < iEnd; ++k)
         {
-            diff1 = pointCurrent;
+            analyzeRefinementCandidate(vecBatch[k]);
         }
+    });
 
-        if (std::find(shared.begin(), shared.end(), pointNeighbour) == shared.end())
+    // Accept the candidates whose cavity and outer triangles are still unclaimed
+    vecRefinementClaims.resize(vecTriangles.size(), 0);
+    std::vector<int> vecAccepted;
+    for (int k = 0; k < iBatchSize; ++k)
+    {
+        const RefinementCandidate& candidate = vecBatch[k];
+        if (candidate.eStatus != CandidateStatus::Insert)
         {
-            diff2 = pointNeighbour;
+            continue;
         }
-    }
-
-    // Retrieve neighbor indices and point indices for both triangles
-    const int iCurrentN0 = triCurrent.getNeighbourIndex(0);
-    const int iCurrentN1 = triCurrent.getNeighbourIndex(1);
-    const int iCurrentN2 = triCurrent.getNeighbourIndex(2);
 
-    const int iNeighbourN0 = triNeighbour.getNeighbourIndex(0);
-    const int iNeighbourN1 = triNeighbour.getNeighbourIndex(1);
-    const int iNeighbourN2 = triNeighbour.getNeighbourIndex(2);
-
-    const int iCurrentPt0 = triCurrent.getPointIndex(0);
-    const int iCurrentPt1 = triCurrent.getPointIndex(1);
-    const int iCurrentPt2 = triCurrent.getPointIndex(2);
-
-    // Replace one of the shared points in triCurrent with diff2
-    for (int i = 0; i < 3; ++i)
-    {
-        if (triCurrent.getPointIndex(i) == shared[0])
+        bool bFree = vecAccepted.size() < iMaxPoints;
+        for (int iIndex : candidate.vecCavity)
         {
-            triCurrent.setPointIndex(i, diff2);
-            triCurrent.setPoint(i, vecPtShape[diff2]);
+            bFree = bFree && !vecRefinementClaims[iIndex];
+        }
+        for (const CavityEdge& edge : candidate.vecStar)
+        {
+            bFree = bFree && (edge.iOuterIndex == -1 || !vecRefinementClaims[edge.iOuterIndex]);
+        }
 
-            // Determine the shared edge and new edge after swap
-            int iSharedEdge = findSharedEdge(triCurrent, diff1, diff2);
-            int iNewEdge = findNewEdge(triCurrent, i, iSharedEdge);
+        if (!bFree)
+        {
+            pqRefinement.push(candidate.entry);
+            continue;
+        }
 
-            int iStolenEdge = -1;
-            if ((triNeighbour.getPointIndex(0) == shared[1] && triNeighbour.getPointIndex(1) == diff2) ||
-                (triNeighbour.getPointIndex(1) == shared[1] && triNeighbour.getPointIndex(0) == diff2))
-            {
-                iStolenEdge = iNeighbourN0;
-            }
-            else if ((triNeighbour.getPointIndex(1) == shared[1] && triNeighbour.getPointIndex(2) == diff2) ||
-                     (triNeighbour.getPointIndex(2) == shared[1] && triNeighbour.getPointIndex(1) == diff2))
-            {
-                iStolenEdge = iNeighbourN1;
-            }
-            else if ((triNeighbour.getPointIndex(2) == shared[1] && triNeighbour.getPointIndex(0) == diff2) ||
-                     (triNeighbour.getPointIndex(0) == shared[1] && triNeighbour.getPointIndex(2) == diff2))
+        for (int iIndex : candidate.vecCavity)
+        {
+            vecRefinementClaims[iIndex] = 1;
+        }
+        for (const CavityEdge& edge : candidate.vecStar)
+        {
+            if (edge.iOuterIndex != -1)
             {
-                iStolenEdge = iNeighbourN2;
+                vecRefinementClaims[edge.iOuterIndex] = 1;
             }
-
-            // Update the neighbor indices in triCurrent
-            triCurrent.setNeighbourIndex(iSharedEdge, iTri2);
-            triCurrent.setNeighbourIndex(iNewEdge, iStolenEdge);
-            break;
         }
+        vecAccepted.push_back(k);
     }
 
-    // Replace one of the shared points in triNeighbour with diff1
-    for (int i = 0; i < 3; ++i)
+    // Release the claims for the next batch
+    for (int k : vecAccepted)
     {
-        if (triNeighbour.getPointIndex(i) == shared[1])
+        for (int iIndex : vecBatch[k].vecCavity)
         {
-            triNeighbour.setPointIndex(i, diff1);
-            triNeighbour.setPoint(i, vecPtShape[diff1]);
-
-            // Determine the shared edge and new edge after swap
-            int iSharedEdge = findSharedEdge(triNeighbour, diff1, diff2);
-            int iNewEdge = findNewEdge(triNeighbour, i, iSharedEdge);
-
-            int iStolenEdge = -1;
-            if ((iCurrentPt0 == diff1 && iCurrentPt1 == shared[0]) ||
-                (iCurrentPt1 == diff1 && iCurrentPt0 == shared[0]))
-            {
-                iStolenEdge = iCurrentN0;
-            }
-            else if ((iCurrentPt1 == diff1 && iCurrentPt2 == shared[0]) ||
-                     (iCurrentPt2 == diff1 && iCurrentPt1 == shared[0]))
-            {
-                iStolenEdge = iCurrentN1;
-            }
-            else if ((iCurrentPt2 == diff1 && iCurrentPt0 == shared[0]) ||
-                     (iCurrentPt0 == diff1 && iCurrentPt2 == shared[0]))
+            vecRefinementClaims[iIndex] = 0;
+        }
+        for (const CavityEdge& edge : vecBatch[k].vecStar)
+        {
+            if (edge.iOuterIndex != -1)
             {
-                iStolenEdge = iCurrentN2;
+                vecRefinementClaims[edge.iOuterIndex] = 0;
             }
-
-            // Update the neighbor indices in triNeighbour
-            triNeighbour.setNeighbourIndex(iSharedEdge, iTri1);
-            triNeighbour.setNeighbourIndex(iNewEdge, iStolenEdge);
-            break;
         }
     }
 
-    // Update neighbor triangles to reflect changes
-    updateNeighboursAfterSwap(iCurrentN0, iTri1, iTri2);
-    updateNeighboursAfterSwap(iCurrentN1, iTri1, iTri2);
-    updateNeighboursAfterSwap(iCurrentN2, iTri1, iTri2);
-    updateNeighboursAfterSwap(iNeighbourN0, iTri2, iTri1);
-    updateNeighboursAfterSwap(iNeighbourN1, iTri2, iTri1);
-    updateNeighboursAfterSwap(iNeighbourN2, iTri2, iTri1);
-}
-
-// Swaps edges in all triangles that have the target point within their circumcircles.
-void Mesh::swapAll(std::queue<int>& neighbourQueue, int iPointIndex)
-{
-    Point& ptTargetPoint = vecPtShape[iPointIndex];
-
-    while (neighbourQueue.size() > 1)
+    // The a-th accepted circumcenter becomes point iFirstPoint + a, and its star gets the two slots after its cavity slots
+    const int iAcceptedCount = vecAccepted.size();
+    const int iFirstPoint = vecPtShape.size();
+    const int iFirstSlot = vecTriangles.size();
+    for (int k : vecAccepted)
     {
-        // Remove the oldest triangle from the queue
-        neighbourQueue.pop();
-
-        // Get the index of the next triangle to process
-        int iNeighbourIndex = neighbourQueue.front();
-        Triangle& triNeighbour = vecTriangles[iNeighbourIndex];
-
-        // Find the triangle that contains the target point
-        int iTriangleIndex = triNeighbour.findPathToContainingTriangle(ptTargetPoint);
+        vecPtShape.push_back(vecBatch[k].ptCenter);
+    }
+    vecTriangles.resize(iFirstSlot + 2 * iAcceptedCount);
+    counters.add(MeshCounter::TrianglesAllocated, 2 * iAcceptedCount);
 
-        // If a valid triangle index is found, perform an edge swap
-        if (iNeighbourIndex >= 0)
+    pool.run(iAcceptedCount, std::max(1, std::min(iThreads, iAcceptedCount / MIN_PARALLEL_CANDIDATES)), [&](int iBegin, int iEnd, int) {
+        for (int a = iBegin; a < iEnd; ++a)
         {
-            swapEdge(iTriangleIndex, iNeighbourIndex);
+            RefinementCandidate& candidate = vecBatch[vecAccepted[a]];
+            candidate.vecCavity.push_back(iFirstSlot + 2 * a);
+            candidate.vecCavity.push_back(iFirstSlot + 2 * a + 1);
+            fillCavity(candidate.vecStar, candidate.vecCavity, iFirstPoint + a, candidate.vecStarOrder);
         }
-    }
-}
+    });
 
-// Finds the index of the shared edge between two triangles based on their differing points.
-int Mesh::findSharedEdge(const Triangle& tri, int iDiff1, int iDiff2) const
-{
-    for (int i = 0; i < 3; ++i)
+    for (int k : vecAccepted)
     {
-        if (((tri.getPointIndex(i) == iDiff1 && tri.getPointIndex((i + 1) % 3) == iDiff2)) ||
-            ((tri.getPointIndex(i) == iDiff2 && tri.getPointIndex((i + 1) % 3) == iDiff1)))
+        for (int iSlot : vecBatch[k].vecCavity)
         {
-            return i;
+            onTriangleChanged(iSlot);
         }
     }
-    return -1; // Return -1 if the edge is not found
-}
 
-// Determines the new edge index for a triangle after an edge swap.
-int Mesh::findNewEdge(const Triangle& tri, int i, int iSharedEdge) const
-{
-    if (i == 0)
+    // Refine the remaining candidates one at a time, unless the batch has changed their triangle
+    int iPointsAdded = iAcceptedCount;
+    for (int k = 0; k < iBatchSize; ++k)
     {
-        if (iSharedEdge == 0)
+        const RefinementCandidate& candidate = vecBatch[k];
+        if (candidate.eStatus != CandidateStatus::Serial || candidate.entry.uVersion != vecTriangleVersions[candidate.entry.iTriangleIndex])
+        {
+            continue;
+        }
+
+        if (iPointsAdded == iMaxPoints)
         {
-            return 2;
+            pqRefinement.push(candidate.entry);
         }
-        else if (iSharedEdge == 2)
+        else if (refineTriangle(candidate.entry.iTriangleIndex))
         {
-            return 0;
+            ++iPointsAdded;
         }
     }
-    else if (i == 1)
+
+    queueChangedTriangles();
+    return iPointsAdded;
+}
+
+// Prepares the insertion of the circumcenter of a refinement candidate without modifying the mesh, so that
+// candidates can be analysed concurrently. The circumcenter is located by a visibility walk from the bad
+// triangle that always tests the edges in the same order, and its cavity is grown by adjacency with the exact
+// incircle test. As in the serial loop, circumcenters outside the mesh or on an existing point are skipped;
+// a cavity with an edge that is not visible from the circumcenter, or that is not a disk, is left to the serial loop.
+void Mesh::analyzeRefinementCandidate(RefinementCandidate& candidate) const
+{
+    const Point& ptCenter = candidate.ptCenter;
+    candidate.eStatus = CandidateStatus::Serial;
+
+    // Walk towards the circumcenter, leaving each triangle through the first edge that separates it from the point
+    int iCurrentIndex = candidate.entry.iTriangleIndex;
+    int iEntryEdge = -1;
+    for (int iSteps = 0; ; ++iSteps)
     {
-        if (iSharedEdge == 0)
+        if (iSteps > vecTriangles.size())
+        {
+            return;  // The walk does not converge, so the serial loop locates the point
+        }
+
+        const Triangle& triCurrent = vecTriangles[iCurrentIndex];
+        int iExitEdge = triCurrent.findExitEdge(ptCenter, 0, iEntryEdge);
+        if (iExitEdge == -1)
         {
-            return 1;
+            counters.add(MeshCounter::WalkSteps, iSteps);
+            break;
         }
-        else if (iSharedEdge == 1)
+
+        int iNextCorner = triCurrent.getNeighbourCorner(iExitEdge);
+        if (iNextCorner == -1)
         {
-            return 0;
+            candidate.eStatus = CandidateStatus::Skip;  // The circumcenter lies outside of the mesh
+            return;
         }
+
+        iCurrentIndex = iNextCorner / 3;
+        iEntryEdge = iNextCorner % 3;
     }
-    else if (i == 2)
+
+    const Triangle& triContaining = vecTriangles[iCurrentIndex];
+    for (int j = 0; j < 3; ++j)
     {
-        if (iSharedEdge == 1)
-        {
-            return 2;
-        }
-        else if (iSharedEdge == 2)
+        const Point ptCorner = triContaining.getPoint(j);
+        if (ptCorner.getX() == ptCenter.getX() && ptCorner.getY() == ptCenter.getY())
         {
-            return 1;
+            candidate.eStatus = CandidateStatus::Skip;  // The circumcenter coincides with an existing point
+            return;
         }
     }
-    return -1; // Return -1 if the new edge index cannot be determined
-}
 
-// Updates the neighbor indices of a triangle when one of its neighbors changes.
-void Mesh::updateNeighboursAfterSwap(int oldNeighborIndex, int oldTriangleIndex, int newTriangleIndex)
-{
-    // Update the neighbor index in the old neighbor triangle if necessary
-    if (oldNeighborIndex != -1 && oldNeighborIndex != oldTriangleIndex && oldNeighborIndex != newTriangleIndex)
+    // Grow the cavity breadth-first and collect its boundary edges
+    std::vector<int>& vecCavity = candidate.vecCavity;
+    std::vector<CavityEdge>& vecStar = candidate.vecStar;
+    vecCavity.push_back(iCurrentIndex);
+
+    for (size_t k = 0; k < vecCavity.size(); ++k)
     {
-        Triangle& oldNeighbor = vecTriangles[oldNeighborIndex];
-        const Triangle& triCurrent = vecTriangles[oldTriangleIndex];
+        const Triangle& triCurrent = vecTriangles[vecCavity[k]];
 
-        // Check if the old neighbor triangle needs to be updated
-        bool needsUpdate = true;
         for (int i = 0; i < 3; ++i)
         {
-            if (triCurrent.getNeighbourIndex(i) == oldNeighborIndex)
-            {
-                needsUpdate = false;
-                break;
-            }
-        }
+            int iNeighbourIndex = triCurrent.getNeighbourIndex(i);
 
-        // Update the neighbor index in the old neighbor triangle
-        if (needsUpdate)
-        {
-            for (int i = 0; i < 3; ++i)
+            if (iNeighbourIndex != -1)
             {
-                if (oldNeighbor.getNeighbourIndex(i) == oldTriangleIndex)
+                if (std::find(vecCavity.begin(), vecCavity.end(), iNeighbourIndex) != vecCavity.end())
                 {
-                    oldNeighbor.setNeighbourIndex(i, newTriangleIndex);
-                    break;
+                    continue;  // Interior edge of the cavity
                 }
+
+                const Triangle& triNeighbour = vecTriangles[iNeighbourIndex];
+                counters.add(MeshCounter::IncircleTests);
+                if (incircle(vecPtShape[triNeighbour.getPointIndex(0)], vecPtShape[triNeighbour.getPointIndex(1)],
+                             vecPtShape[triNeighbour.getPointIndex(2)], ptCenter) > 0)
+                {
+                    vecCavity.push_back(iNeighbourIndex);
+                    continue;
+                }
+            }
+
+            CavityEdge edge;
+            edge.iPointA = triCurrent.getPointIndex(i);
+            edge.iPointB = triCurrent.getPointIndex((i + 1) % 3);
+            edge.iOuterIndex = iNeighbourIndex;
+            edge.iOuterEdge = iNeighbourIndex != -1 ? triCurrent.getNeighbourCorner(i) % 3 : -1;
+            edge.iInnerIndex = vecCavity[k];
+
+            if (orient2d(vecPtShape[edge.iPointA], vecPtShape[edge.iPointB], ptCenter) <= 0)
+            {
+                vecCavity.clear();
+                vecStar.clear();
+                return;
             }
+
+            vecStar.push_back(edge);
         }
     }
+
+    if (vecStar.size() != vecCavity.size() + 2)
+    {
+        vecCavity.clear();
+        vecStar.clear();
+        return;
+    }
+
+    candidate.eStatus = CandidateStatus::Insert;
 }
 
-// Adjusts triangles to make them more equilateral by adding new points and creating new triangles.
-void Mesh::equilateralizeTriangles()
+// Scores every triangle with the batched quality kernel and queues the bad ones. The triangles are copied block
+// by block into coordinate arrays; the angles are considered as in getRefinementScore.
+void Mesh::queueAllRefinementCandidates()
 {
-    int smallestAngleTriangleIndex;
-    int iterationCount = 0;
+    double adX[3][QUALITY_BATCH_SIZE], adY[3][QUALITY_BATCH_SIZE], adScore[3][QUALITY_BATCH_SIZE];
+    const double* const apdX[3] = { adX[0], adX[1], adX[2] };
+    const double* const apdY[3] = { adY[0], adY[1], adY[2] };
+    double* const apdScore[3] = { adScore[0], adScore[1], adScore[2] };
 
-    // Continuously process triangles until no triangles with small angles are found
-    while ((smallestAngleTriangleIndex = locateSmallestAngle()) >= 0)
+    for (int iBlockStart = 0; iBlockStart < vecTriangles.size(); iBlockStart += QUALITY_BATCH_SIZE)
     {
-        // Retrieve the triangle with the smallest angle
-        auto& triangle = vecTriangles[smallestAngleTriangleIndex];
+        const int iCount = std::min<int>(QUALITY_BATCH_SIZE, vecTriangles.size() - iBlockStart);
 
-        Point circumcenter = triangle.getCircumcenter();
+        for (int k = 0; k < iCount; ++k)
+        {
+            const Triangle& triangle = vecTriangles[iBlockStart + k];
+            for (int j = 0; j < 3; ++j)
+            {
+                const Point pt = triangle.getPoint(j);
+                adX[j][k] = pt.getX();
+                adY[j][k] = pt.getY();
+            }
+        }
 
-        vecPtShape.push_back(circumcenter);
+        angleScoreBatch(apdX, apdY, iCount, apdScore);
 
-        // Find the triangle that contains the circumcenter
-        int containingTriangleIndex = findContainingTriangle(circumcenter);
+        for (int k = 0; k < iCount; ++k)
+        {
+            const Triangle& triangle = vecTriangles[iBlockStart + k];
+            if (triangle.isFree())
+            {
+                continue;
+            }
 
-        int newPointIndex = vecPtShape.size() - 1;
+            double minScore = 1.0;
+            for (int j = 0; j < 3; ++j)
+            {
+                minScore = std::min(minScore, adScore[j][k]);
 
-        // Create new triangles by connecting the new point with the containing triangle
-        createTriangles(containingTriangleIndex, newPointIndex);
+                // Check if the edge is a border case (i.e., has no neighbor)
+                if (triangle.getNeighbourIndex(j) == -1)
+                {
+                    break;  // No need to check further angles for this triangle
+                }
+            }
 
-        // For debugging purposes,
-        //if (++iterationCount == 3){break;}
+            if (minScore < refinementThreshold.dSin2)
+            {
+                pqRefinement.push({ minScore, iBlockStart + k, vecTriangleVersions[iBlockStart + k] });
+            }
+        }
     }
 }
 
-// Finds the index of the triangle with the smallest angle to be processed for equilateralization.
-int Mesh::locateSmallestAngle()
+// Gets the score of the smallest angle of a triangle considered by the refinement.
+// The angles are checked in order, and the check stops after the angle of the first edge on the border.
+double Mesh::getRefinementScore(int iTriangleIndex) const
 {
-    double minAngle = 180.0; // Initialize with the largest possible angle
-    int minAngleTriangleIndex = -1; // Index of the triangle with the smallest angle
+    const Triangle& triangle = vecTriangles[iTriangleIndex];
+    double minScore = 1.0;
 
-    // Update the minimum angle and corresponding triangle index
-    auto updateMinAngle = [&](double angle, int triangleIndex) {
-        if (angle < minAngle)
+    // Check each angle of the triangle
+    for (int j = 0; j < 3; ++j)
+    {
+        double score = angleScore(triangle, j);
+        if (score < minScore)
         {
-            minAngle = angle;
-            minAngleTriangleIndex = triangleIndex;
+            minScore = score;
         }
-    };
 
-    // Iterate over all triangles in the mesh
-    for (const auto& triangle : vecTriangles)
-    {
-        // Check each angle of the triangle
-        for (int j = 0; j < 3; ++j)
+        // Check if the edge is a border case (i.e., has no neighbor)
+        if (triangle.getNeighbourIndex(j) == -1)
         {
-            int neighborIndex = triangle.getNeighbourIndex(j);
-
-            // Check if the edge is a border case (i.e., has no neighbor)
-            if (neighborIndex == -1)
-            {
-                double innerAngle = triangle.getAng(j);
-                updateMinAngle(innerAngle, triangle.getIndex());
-                break;  // No need to check further angles for this triangle
-            }
-            else
-            {
-                updateMinAngle(triangle.getAng(j), triangle.getIndex());
-            }
+            break;  // No need to check further angles for this triangle
         }
     }
 
-    // Return the index of the triangle with the smallest angle if it's below threshold, else return -1
-    if (minAngle < 40.0)
+    return minScore;
+}
+
+// Queues a triangle for refinement if its smallest angle is below the threshold. The division-free threshold test
+// (same angles as getRefinementScore) rejects the good triangles; only the bad ones pay for the score that orders the queue.
+void Mesh::pushRefinementCandidate(int iTriangleIndex)
+{
+    const Triangle& triangle = vecTriangles[iTriangleIndex];
+    bool bBad = false;
+    for (int j = 0; j < 3 && !bBad; ++j)
     {
-        return minAngleTriangleIndex;
+        bBad = isAngleBelow(triangle, j, refinementThreshold);
+
+        // Check if the edge is a border case (i.e., has no neighbor)
+        if (triangle.getNeighbourIndex(j) == -1)
+        {
+            break;  // No need to check further angles for this triangle
+        }
     }
-    else
+
+    if (bBad)
     {
-        return -1;
+        pqRefinement.push({ getRefinementScore(iTriangleIndex), iTriangleIndex, vecTriangleVersions[iTriangleIndex] });
     }
 }
@@ -4,9 +4,36 @@
 
 #include "point.h"
 #include "triangle.h"
+#include "gridindex.h"
+#include "compactmesh.h"
+#include "quality.h"
+#include "meshstats.h"
+#include "span.h"
 
 #include <vector>
+#include <random>
 #include <queue>
+#include <functional>
+
+class WorkerPool;
+
+// Storage moved out of a mesh by Mesh::release
+struct MeshBuffers {
+    std::vector<Point> vecPoints;  // Points, including the super triangle points if they were not removed
+    std::vector<Triangle> vecTriangles;  // Triangles referring to the points by index
+};
+
+// Placement of the super triangle that encloses the points during the build
+enum class SuperTriangleMode {
+    BoundingBox,  // Equilateral triangle around the bounding box of the points, enlarged by a margin
+    Symbolic  // Far away vertices treated as points at infinity by the conflict test
+};
+
+// Algorithm used to insert a point into the triangulation
+enum class InsertionEngine {
+    SplitAndFlip,  // Split the containing triangle, then restore the Delaunay property with edge swaps
+    BowyerWatson  // Remove all triangles in conflict with the point and retriangulate the cavity as a star
+};
 
 // Class representing a 2D mesh composed of points and triangles
 class Mesh {
@@ -16,28 +43,241 @@ private:
     std::vector<Point> vecPtShape;  // Vector of points defining the shape
     std::vector<Triangle> vecTriangles;  // Vector of triangles defining the shape
 
+    SuperTriangleMode eSuperTriangleMode{SuperTriangleMode::BoundingBox};  // Placement of the super triangle
+    double dSuperTriangleMargin{1.0};  // Margin of the super triangle, relative to the half diagonal of the bounding box
+    int iSuperPointIndex{-1};  // Index of the first super triangle point in vecPtShape (-1 if there is none)
+
+    static constexpr double SYMBOLIC_SUPER_TRIANGLE_SCALE = 1.0e3;  // Enlargement of the super triangle in symbolic mode
+
+    InsertionEngine eInsertionEngine{InsertionEngine::SplitAndFlip};  // Engine used to insert points
+
+    // Edge on the boundary of a Bowyer-Watson cavity, oriented counter-clockwise around the cavity
+    struct CavityEdge {
+        int iPointA, iPointB;  // Point indices of the edge
+        int iOuterIndex;  // Triangle outside of the cavity sharing the edge (-1 if none)
+        int iOuterEdge;  // Edge of the outer triangle that faces the cavity
+        int iInnerIndex;  // Cavity triangle the edge was taken from
+    };
+
+    bool bSpatialSort{false};  // Whether buildMesh inserts points in BRIO / Hilbert order
+    unsigned int uSortSeed{0};  // Seed used to assign points to BRIO rounds
+    std::vector<int> vecInsertionOrder;  // Insertion order used by the last build (k-th inserted point -> index in vecPtShape)
+
+    bool bParallelBuild{false};  // Whether buildMesh uses the parallel divide-and-conquer engine
+    bool bParallelRefinement{false};  // Whether equilateralizeTriangles refines conflict-free batches in parallel
+    int iThreadCount{0};  // Number of threads used by the parallel build and refinement (0 uses every hardware thread)
+
+    mutable std::mt19937 genWalk{5489u};  // Random number generator driving the point location walk
+    MeshCounters counters;  // Per-thread hot-path counters and phase timings reported by stats()
+
+    bool bUseGridIndex{false};  // Whether point location is seeded from the bucket grid
+    int iGridCellsPerAxis{0};  // Requested grid resolution (0 selects it from the triangle count)
+    GridIndex gridIndex;  // Bucket grid mapping cells to representative triangles
+
+    mutable std::vector<double> vecConflictScratch;  // Coordinate arrays and results of the batched conflict test
+    mutable std::vector<int> vecConflictLanes;  // Candidates placed in the batch of the conflict test
+
+    std::vector<int> vecLegalizeStack;  // Corners (triangle * 3 + edge) waiting for a Delaunay check, each with the new point opposite
+
+    // Scratch buffers of the Bowyer-Watson insertion, kept between insertions so that a steady-state insertion does not allocate
+    std::vector<int> vecCavityScratch;  // Slots of the triangles in conflict with the point
+    std::vector<CavityEdge> vecBoundaryScratch;  // Edges on the boundary of the cavity
+    std::vector<CavityEdge> vecStarScratch;  // Boundary edges that get a star triangle
+    std::vector<int> vecCandidateScratch;  // Neighbours of the current wave that still have to be tested
+    std::vector<char> vecConflictScratchFlags;  // Conflict test results of the candidates
+    std::vector<int> vecSlotScratch;  // Slots of the star triangles
+    std::vector<int> vecStarOrderScratch;  // Star triangles sorted by their first point
+
+    // Epoch-stamped visit marks: a slot is marked for the current epoch when its stamp equals it, so clearing the marks
+    // is a matter of advancing the epoch instead of touching every slot. The epochs are 64-bit so that they never wrap,
+    // not even in the middle of an insertion whose marks must survive its later epochs.
+    std::vector<unsigned long long> vecTriangleMarks;  // Stamp of each triangle slot
+    unsigned long long uMarkEpoch{0};  // Last epoch handed out
+
+    // Ear of the link polygon of a removed point, queued by priority
+    struct EarCandidate {
+        double dPriority;  // Power of the removed point with respect to the circumcircle of the ear, up to a positive factor
+        int iVertex;  // Link vertex at the tip of the ear
+        unsigned int uStamp;  // Stamp of the tip when the ear was queued; the ear is stale once the stamp moves on
+        bool operator<(const EarCandidate& other) const { return dPriority < other.dPriority; }
+    };
+
+    std::vector<int> vecFreeTriangleSlots;  // Slots freed by removePoint, reused before the triangle vector grows
+    std::vector<int> vecVertexTriangles;  // A triangle slot having each point as a corner; a hint, checked before use (-1 if unknown)
+    bool bVertexTrianglesComplete{false};  // Whether every vertex has a hint: set by a rebuild, cleared when the slots are renumbered
+
+    // Scratch buffers of removePoint, indexed by link vertex (the link polygon is counter-clockwise)
+    std::vector<int> vecRemovalStar;  // Slots of the triangles around the removed point
+    std::vector<int> vecLinkPoints;  // Point index of each link vertex
+    std::vector<int> vecLinkOuter;  // Encoded corner outside the edge from each link vertex to the next one
+    std::vector<int> vecLinkPrev, vecLinkNext;  // Link vertices still in the polygon, as a doubly linked ring
+    std::vector<unsigned int> vecLinkStamps;  // Stamp of each link vertex, bumped when its ear changes or it is clipped
+    std::vector<EarCandidate> vecEarHeap;  // Max-heap of the convex ears
+    std::vector<int> vecEarSequence;  // Link vertices (a, b, c) of every clipped ear, in order
+
+    static constexpr double REFINEMENT_ANGLE_THRESHOLD = 40.0;  // Triangles with a smaller angle (in degrees) are refined
+    AngleThreshold refinementThreshold{REFINEMENT_ANGLE_THRESHOLD};  // Squared sine and cosine of the refinement threshold
+    static constexpr int QUALITY_BATCH_SIZE = 256;  // Number of triangles scored per call of the batched quality kernel
+    static constexpr int REFINEMENT_POINTS_PER_TRIANGLE = 4;  // Default number of points the refinement may add per initial triangle
+    int iRefinementPointLimit{0};  // Maximum number of points added by equilateralizeTriangles (0 picks one from the triangle count)
+
+    // Entry of the refinement queue: a bad triangle keyed by the score of its smallest angle, valid while its slot keeps the same version
+    struct RefinementEntry {
+        double dScore;  // Angle score (see angleScore) of the smallest angle when the entry was queued
+        int iTriangleIndex;  // Triangle slot
+        unsigned int uVersion;  // Version of the slot when the entry was queued
+
+        // Orders the entries by score, then by slot, so the queue pops the same triangle a full scan would pick
+        bool operator>(const RefinementEntry& other) const
+        {
+            return dScore > other.dScore || (dScore == other.dScore && iTriangleIndex > other.iTriangleIndex);
+        }
+    };
+
+    std::priority_queue<RefinementEntry, std::vector<RefinementEntry>, std::greater<RefinementEntry>> pqRefinement;  // Bad triangles, smallest angle first
+    bool bTrackChangedTriangles{false};  // Whether onTriangleChanged records slots for the refinement queue
+    std::vector<unsigned int> vecTriangleVersions;  // Version of each triangle slot, bumped whenever the slot changes
+    std::vector<int> vecChangedTriangles;  // Slots changed by the current insertion, waiting to be queued
+    bool bTrackRelinkedTriangles{false};  // Whether linkNeighbours also records the neighbours it relinks (insertPoints)
+
+    static constexpr int REFINEMENT_BATCH_SIZE = 1024;  // Maximum number of queue entries taken by a parallel refinement batch
+    static constexpr int MIN_PARALLEL_CANDIDATES = 64;  // Minimum number of candidates handed to each thread of a batch
+
+    // Outcome of the analysis of a refinement candidate
+    enum class CandidateStatus {
+        Insert,  // The cavity is a star around the circumcenter and can be retriangulated within the batch
+        Skip,  // The circumcenter lies outside of the mesh or on an existing point
+        Serial  // The cavity needs the serial insertion
+    };
+
+    // Bad triangle of a parallel refinement batch with the Bowyer-Watson cavity of its circumcenter
+    struct RefinementCandidate {
+        RefinementEntry entry;  // Queue entry of the bad triangle
+        Point ptCenter;  // Circumcenter of the bad triangle
+        CandidateStatus eStatus{CandidateStatus::Serial};  // Outcome of the analysis
+        std::vector<int> vecCavity;  // Slots of the cavity
+        std::vector<CavityEdge> vecStar;  // Boundary edges of the cavity, counter-clockwise, one per star triangle
+        std::vector<int> vecStarOrder;  // Scratch order of the star triangles used by fillCavity
+    };
+
+    std::vector<RefinementCandidate> vecRefinementBatch;  // Candidates of the current parallel refinement batch
+    std::vector<char> vecRefinementClaims;  // Slots claimed by the candidates accepted into the current batch
+
 public:
 
     // Constructor to initialize mesh with a set of points
     Mesh(const std::vector<Point>& vecPt);
 
+    // Constructor to initialize mesh with a set of points, taking over their storage (e.g. the result of a point loader)
+    Mesh(std::vector<Point>&& vecPt);
+
     // Getters and setters for the shape
     std::vector<Point> getShape() const;
     void setShape(const std::vector<Point>& vecPt);
+    void setShape(std::vector<Point>&& vecPt);
+
+    // Setter for the shape from a range of points, such as the points of a mapped PointFile (copied once into the mesh)
+    void setShape(const Point* pBegin, const Point* pEnd);
 
     // Getters and setters for the vector of Triangles (for testing purposes only)
     void setTriVector(const std::vector<Triangle>& vecTri);
+    void setTriVector(std::vector<Triangle>&& vecTri);
     std::vector<Triangle> getTriVector() const;
 
+    // Views of the points and triangles without copying; they are invalidated by any call that adds points or triangles.
+    // The triangles include the slots freed by removePoint, which read as Triangle::isFree and are to be skipped.
+    Span<const Point> getShapeView() const;
+    Span<const Triangle> getTriView() const;
+
+    // Function to move the points and triangles out of the mesh, leaving it empty (free slots are moved out as they are)
+    MeshBuffers release();
+
+    // Function to reserve room for a mesh of uPointCount points: the points plus the super triangle, and the
+    // 2n + 1 triangles that the Euler formula gives for n points inside a super triangle
+    void reserve(size_t uPointCount);
+
+    // Function to copy the mesh into the compact structure-of-arrays representation, leaving out the free slots
+    CompactMesh toCompact() const;
+
+    // Enables or disables the spatially sorted (BRIO / Hilbert) insertion order used by buildMesh
+    void setSpatialSort(bool bEnable, unsigned int uSeed = 0);
+    bool getSpatialSort() const;
+
+    // Returns the insertion order of the last build, mapping each insertion step to the original point index
+    const std::vector<int>& getInsertionOrder() const;
+
+    // Enables or disables the parallel divide-and-conquer build used by buildMesh (iThreads = 0 uses every hardware thread)
+    void setParallelBuild(bool bEnable, int iThreads = 0);
+    bool getParallelBuild() const;
+    int getThreadCount() const;
+
+    // Enables or disables the parallel refinement used by equilateralizeTriangles (iThreads = 0 uses every hardware thread)
+    void setParallelRefinement(bool bEnable, int iThreads = 0);
+    bool getParallelRefinement() const;
+
     // Function to build the mesh from points and triangles
     void buildMesh();
 
-    // Function to finds the index the triangle that contains a specific point
-    int findContainingTriangle(const Point& ptTargetPoint) const;
+    // Function to insert points into a built mesh, returning the slots of the triangles created, reshaped or relinked, once each.
+    // The super triangle, if it was not removed yet, stays in place so later batches can land outside of the hull;
+    // points outside of the mesh or on an existing point are skipped.
+    std::vector<int> insertPoints(Span<const Point> spanPoints);
+
+    // Function to remove an interior point and retriangulate the polygon left around it, in time proportional to its degree.
+    // The point keeps its entry in the shape, unreferenced, and no other triangle moves, so point and triangle indices held
+    // by the caller stay valid. The two slots left over become free (Triangle::isFree) until a later insertion reuses them.
+    // The slots rewritten, relinked or freed are appended to pvecChanged. Returns false for points on the boundary of the
+    // mesh, super triangle points and points that are not a vertex of the mesh.
+    bool removePoint(int iPointIndex, std::vector<int>* pvecChanged = nullptr);
+
+    // Function to build the mesh with the parallel divide-and-conquer engine, treating the super triangle points as ordinary points
+    void buildMeshDivideAndConquer(int iPointCount);
+
+    // Function to finds the index the triangle that contains a specific point, optionally starting from a given triangle
+    int findContainingTriangle(const Point& ptTargetPoint, int iStartIndex = -1) const;
+
+    // Function to pick a starting triangle near a point by sampling about n^(1/3) triangles
+    int findJumpStart(const Point& ptTargetPoint) const;
+
+    // Function to take a snapshot of the hot-path counters and phase timings (zero when DELAUNAY_ENABLE_STATS is 0)
+    MeshStats stats() const;
+
+    // Function to zero the counters and phase timings
+    void resetStats();
+
+    // Enables the bucket-grid point location index (iCellsPerAxis = 0 picks about two triangles per cell)
+    void enableGridIndex(int iCellsPerAxis = 0);
+
+    // Disables the bucket-grid point location index
+    void disableGridIndex();
+
+    // Returns whether the bucket-grid point location index is enabled
+    bool hasGridIndex() const;
+
+    // Rebuilds the bucket grid from the current triangles
+    void rebuildGridIndex();
+
+    // Notifies the acceleration structures that a triangle slot was reused or appended
+    void onTriangleChanged(int iTriangleIndex);
+
+    // Setters and getters for the placement and margin of the super triangle
+    void setSuperTriangleMode(SuperTriangleMode eMode);
+    SuperTriangleMode getSuperTriangleMode() const;
+    void setSuperTriangleMargin(double dMargin);
+    double getSuperTriangleMargin() const;
 
     // Function to create a super triangle that encloses all points
     Triangle superTriangle();
 
+    // Function to check whether a point index refers to one of the super triangle points
+    bool isSuperPoint(int iPointIndex) const;
+
+    // Function to check whether a point lies inside the circumcircle of a triangle (super triangle aware)
+    bool isInConflict(int iTriangleIndex, const Point& pt) const;
+
+    // Function to test several triangles for conflict with a point at once (one result per candidate, super triangle aware)
+    void findConflicts(const std::vector<int>& vecCandidates, const Point& pt, std::vector<char>& vecConflict) const;
+
     // Removes helper triangles used for intermediate computations
     void removeHelperTriangles();
 
@@ -47,44 +287,90 @@ public:
     // Updates neighboring triangles when a triangle is removed
     void updateRemovedNeighbours(int iRemovedTriangleIndex);
 
+    // Setters and getters for the point insertion engine
+    void setInsertionEngine(InsertionEngine eEngine);
+    InsertionEngine getInsertionEngine() const;
+
+    // Function to insert a point into the triangle that contains it using the selected engine
+    void insertPoint(int iTriangleIndex, int iPointIndex);
+
+    // Function to append a point to the shape without inserting it, returning its index for insertPoint
+    int addPoint(const Point& pt);
+
+    // Function to insert a point by retriangulating its Bowyer-Watson cavity
+    void insertPointBowyerWatson(int iTriangleIndex, int iPointIndex);
+
+    // Function to retriangulate a cavity as a star around a point, writing the star triangles into the given slots
+    // (vecOrder is scratch space, so concurrent calls on disjoint cavities each pass their own)
+    void fillCavity(const std::vector<CavityEdge>& vecStar, const std::vector<int>& vecSlots, int iPointIndex, std::vector<int>& vecOrder);
+
+    // Function to reserve iCount consecutive mark epochs for the current triangle slots and return the first one
+    unsigned long long nextMarkEpochs(unsigned int iCount);
+
+    // Function to queue the ear of the link polygon at a link vertex if it is convex, invalidating its older entries
+    void queueEar(int iVertex, const Point& ptRemoved);
+
+    // Function to take a free triangle slot, or append one, for a triangle about to be written
+    int allocateTriangleSlot();
+
+    // Function to find the corner of a triangle slot holding a point, -1 if the slot is free, out of range or lacks the point
+    int findVertexCorner(int iTriangleIndex, int iPointIndex) const;
+
+    // Function to recompute the incident triangle hint of every point
+    void rebuildVertexTriangles();
+
     // Function to create new triangles
     void createTriangles(int iTriangleIndex, int iPointIndex);
 
     //Function to handle edge case
     void handleEdgeCase(int iTriangleIndex, int iPointIndex);
 
-    // Creates new triangles on the opposite side of a specified triangle and point
-    void createTrianglesOppositeSide(int iTriangleIndex, int iPointIndex, int iNeighbourIndex0, int iNeighbourIndex1);
-
-    // Updates the neighboring triangles' edge references after swapping edges
-    void updateEdgeNeighbours(int iTriangleIndex, int iNewTriangleIndex, int iNeighbourIndex0, int iNeighbourIndex1);
+    // Function to build a triangle from three point indices, without neighbours
+    Triangle makeTriangle(int iTriangleIndex, int iPointA, int iPointB, int iPointC) const;
 
-    // Checks if two triangles are neighbors (share an edge)
-    bool areNeighbours(int iTri1, int iTri2);
+    // Links an edge of a triangle with an encoded neighbour corner (triangle * 3 + edge, or -1) in both directions
+    void linkNeighbours(int iTriangleIndex, int iEdge, int iCorner);
 
-    // Checks if a point is inside the circumcircles of neighboring triangles
-    std::queue<int> checkNeighboringCircumcircles(int iTriangleIndex, int iPointIndex, int iEdgeIndex);
+    // Rebuilds the encoded neighbour corners from the neighbour indices and point indices of the triangles
+    void resolveNeighbourCorners();
 
     // Function to swap edge between neighbouring triangles
     void swapEdge(int iTri1, int iTri2);
 
-    // Performs edge swaps on all neighboring triangles containing a specific point
-    void swapAll(std::queue<int>& neighbourQueue, int iPointIndex);
-
-    // Finds the shared edge between two triangles
-    int findSharedEdge(const Triangle& tri, int iDiff1, int iDiff2) const;
+    // Function to flip the edge across a given edge of a triangle
+    void flipEdge(int iTriangleIndex, int iEdge);
 
-    // Finds the new edge index after swapping edges
-    int findNewEdge(const Triangle& tri, int i, int iSharedEdge) const;
+    // Restores the Delaunay property around a newly inserted point by flipping the edges queued in vecLegalizeStack
+    void legalizeEdges(int iPointIndex);
 
-    // Updates neighboring relationships between triangles
-    void updateNeighboursAfterSwap(int oldNeighborIndex, int oldTriangleIndex, int newTriangleIndex);
+    // Setters and getters for the maximum number of points the refinement may add (0 picks one from the triangle count)
+    void setRefinementPointLimit(int iLimit);
+    int getRefinementPointLimit() const;
 
     // Equilateralizes triangles by adding new points to improve the mesh quality
     void equilateralizeTriangles();
 
-    // Locates the triangle with the smallest angle
-    int locateSmallestAngle();
+    // Function to insert the circumcenter of a bad triangle, returning whether a point was added
+    bool refineTriangle(int iTriangleIndex);
+
+    // Queues the slots changed since the last call for refinement
+    void queueChangedTriangles();
+
+    // Function to refine a conflict-free batch of bad triangles in parallel, returning the number of points added
+    int refineBatch(WorkerPool& pool, int iMaxPoints);
+
+    // Function to locate the circumcenter of a refinement candidate and collect its cavity without modifying the mesh
+    void analyzeRefinementCandidate(RefinementCandidate& candidate) const;
+
+    // Function to get the score (see angleScore) of the smallest angle of a triangle considered by the refinement
+    // (angles are checked in order and the check stops after the first border edge)
+    double getRefinementScore(int iTriangleIndex) const;
+
+    // Queues a triangle for refinement if its smallest angle is below the threshold
+    void pushRefinementCandidate(int iTriangleIndex);
+
+    // Function to score every triangle with the batched quality kernel and queue those below the threshold
+    void queueAllRefinementCandidates();
 
 };
 
@@ -0,0 +1,488 @@
+#include "meshio.h"
+#include "predicates.h"
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+// Header of a binary mesh file
+struct MeshFileHeader {
+    char acMagic[8];
+    uint32_t uVersion;
+    uint32_t uHeaderSize;
+    uint64_t uPointCount;
+    uint64_t uTriangleCount;
+};
+
+static_assert(sizeof(MeshFileHeader) == 32, "The binary mesh header must be 32 bytes");
+
+static const char MESH_FILE_MAGIC[8] = { 'D', 'M', 'E', 'S', 'H', 'B', 'I', 'N' };
+
+// Size of the buffer of the exporters
+static const size_t OUTPUT_BUFFER_SIZE = 1 << 20;
+
+// Checks whether the host stores numbers little-endian, as the binary formats do
+static bool isLittleEndian()
+{
+    const uint16_t uValue = 1;
+    unsigned char ucFirst;
+    std::memcpy(&ucFirst, &uValue, 1);
+    return ucFirst == 1;
+}
+
+// Buffered file writer: values are formatted with std::to_chars or copied into a large buffer that is written in one call when full
+class OutputBuffer {
+
+private:
+    std::FILE* pFile;  // Output file (nullptr if it could not be created)
+    std::vector<char> vecBuffer;  // Bytes waiting to be written
+    size_t uUsed{0};  // Number of bytes used in the buffer
+    bool bFailed{false};  // Whether a write failed
+
+public:
+    // Creates the output file
+    explicit OutputBuffer(const std::string& sPath) : pFile(std::fopen(sPath.c_str(), "wb")), vecBuffer(OUTPUT_BUFFER_SIZE)
+    {
+        if (!pFile)
+        {
+            std::cerr << "Could not create " << sPath << "." << std::endl;
+        }
+    }
+
+    // Writes the rest of the buffer and closes the file
+    ~OutputBuffer()
+    {
+        close();
+    }
+
+    // Checks whether the file was created
+    bool isOpen() const
+    {
+        return pFile != nullptr;
+    }
+
+    // Writes the buffered bytes to the file
+    void flush()
+    {
+        if (pFile && uUsed > 0 && std::fwrite(vecBuffer.data(), 1, uUsed, pFile) != uUsed)
+        {
+            bFailed = true;
+        }
+        uUsed = 0;
+    }
+
+    // Makes room for at least uBytes bytes (uBytes must not exceed the buffer size)
+    char* reserve(size_t uBytes)
+    {
+        if (uUsed + uBytes > vecBuffer.size())
+        {
+            flush();
+        }
+        return vecBuffer.data() + uUsed;
+    }
+
+    // Appends raw bytes
+    void write(const void* pData, size_t uBytes)
+    {
+        const char* pBytes = static_cast<const char*>(pData);
+        while (uBytes > 0)
+        {
+            size_t uChunk = std::min(uBytes, vecBuffer.size());
+            std::memcpy(reserve(uChunk), pBytes, uChunk);
+            uUsed += uChunk;
+            pBytes += uChunk;
+            uBytes -= uChunk;
+        }
+    }
+
+    // Appends an array of 32-bit values in little-endian byte order
+    template <typename T>
+    void writeLittleEndian(const T* pValues, size_t uCount)
+    {
+        static_assert(sizeof(T) == 4, "Only 32-bit values are swapped");
+        if (isLittleEndian())
+        {
+            write(pValues, uCount * sizeof(T));
+            return;
+        }
+
+        for (size_t k = 0; k < uCount; ++k)
+        {
+            unsigned char acBytes[4];
+            std::memcpy(acBytes, &pValues[k], 4);
+            std::swap(acBytes[0], acBytes[3]);
+            std::swap(acBytes[1], acBytes[2]);
+            write(acBytes, 4);
+        }
+    }
+
+    // Appends text
+    OutputBuffer& operator<<(const char* psText)
+    {
+        write(psText, std::strlen(psText));
+        return *this;
+    }
+
+    // Appends a character
+    OutputBuffer& operator<<(char c)
+    {
+        *reserve(1) = c;
+        ++uUsed;
+        return *this;
+    }
+
+    // Appends a number in its shortest round-trip form
+    template <typename T>
+    OutputBuffer& operator<<(T value)
+    {
+        char* p = reserve(32);
+        uUsed = std::to_chars(p, p + 32, value).ptr - vecBuffer.data();
+        return *this;
+    }
+
+    // Writes the rest of the buffer and closes the file; returns false if any write failed
+    bool close()
+    {
+        if (!pFile)
+        {
+            return false;
+        }
+
+        flush();
+        bFailed = std::fclose(pFile) != 0 || bFailed;
+        pFile = nullptr;
+        return !bFailed;
+    }
+
+};
+
+// Maps a binary mesh file and checks its header and size
+bool MeshFile::open(const std::string& sPath)
+{
+    close();
+
+    if (!isLittleEndian())
+    {
+        std::cerr << "Binary mesh files can only be mapped on little-endian hosts." << std::endl;
+        return false;
+    }
+
+    if (!file.open(sPath))
+    {
+        return false;
+    }
+
+    MeshFileHeader header;
+    if (file.size() < sizeof(header))
+    {
+        std::cerr << sPath << " is too small to be a binary mesh file." << std::endl;
+        file.close();
+        return false;
+    }
+    std::memcpy(&header, file.data(), sizeof(header));
+
+    if (std::memcmp(header.acMagic, MESH_FILE_MAGIC, sizeof(MESH_FILE_MAGIC)) != 0)
+    {
+        std::cerr << sPath << " is not a binary mesh file." << std::endl;
+        file.close();
+        return false;
+    }
+
+    if (header.uVersion > MESH_FILE_VERSION || header.uHeaderSize < sizeof(header) || header.uHeaderSize % 4 != 0 ||
+        header.uPointCount > INT32_MAX || header.uTriangleCount > INT32_MAX / 3)
+    {
+        std::cerr << sPath << " has an unsupported version (" << header.uVersion << ") or header." << std::endl;
+        file.close();
+        return false;
+    }
+
+    const uint64_t uExpectedSize = header.uHeaderSize + 8 * header.uPointCount + 24 * header.uTriangleCount;
+    if (file.size() != uExpectedSize)
+    {
+        std::cerr << sPath << " is truncated or has trailing data (" << file.size() << " bytes instead of " << uExpectedSize << ")." << std::endl;
+        file.close();
+        return false;
+    }
+
+    iPointCount = static_cast<int>(header.uPointCount);
+    iTriangleCount = static_cast<int>(header.uTriangleCount);
+
+    const char* pBlock = file.data() + header.uHeaderSize;
+    pX = reinterpret_cast<const float*>(pBlock);
+    pY = pX + iPointCount;
+    pVertices = reinterpret_cast<const int*>(pY + iPointCount);
+    pNeighbours = pVertices + 3 * iTriangleCount;
+    return true;
+}
+
+// Unmaps the file
+void MeshFile::close()
+{
+    file.close();
+    iPointCount = iTriangleCount = 0;
+    pX = pY = nullptr;
+    pVertices = pNeighbours = nullptr;
+}
+
+// Returns the number of points
+int MeshFile::getPointCount() const
+{
+    return iPointCount;
+}
+
+// Returns the number of triangles
+int MeshFile::getTriangleCount() const
+{
+    return iTriangleCount;
+}
+
+// Returns a point
+Point MeshFile::getPoint(int iPointIndex) const
+{
+    return Point(pX[iPointIndex], pY[iPointIndex]);
+}
+
+// Returns the x coordinate of a point
+float MeshFile::getX(int iPointIndex) const
+{
+    return pX[iPointIndex];
+}
+
+// Returns the y coordinate of a point
+float MeshFile::getY(int iPointIndex) const
+{
+    return pY[iPointIndex];
+}
+
+// Returns the index of a point of a triangle
+int MeshFile::getVertex(int iTriangleIndex, int iCorner) const
+{
+    return pVertices[3 * iTriangleIndex + iCorner];
+}
+
+// Returns the neighbour across an edge of a triangle
+int MeshFile::getNeighbour(int iTriangleIndex, int iEdge) const
+{
+    return pNeighbours[3 * iTriangleIndex + iEdge];
+}
+
+// Returns the mapped x coordinates
+const float* MeshFile::getXArray() const
+{
+    return pX;
+}
+
+// Returns the mapped y coordinates
+const float* MeshFile::getYArray() const
+{
+    return pY;
+}
+
+// Returns the mapped point indices of the triangles
+const int* MeshFile::getVertexArray() const
+{
+    return pVertices;
+}
+
+// Returns the mapped neighbour indices of the triangles
+const int* MeshFile::getNeighbourArray() const
+{
+    return pNeighbours;
+}
+
+// Finds the triangle containing a point with the same visibility walk as CompactMesh
+int MeshFile::findContainingTriangle(const Point& pt, int iStartIndex) const
+{
+    if (iTriangleCount == 0)
+    {
+        return -1;
+    }
+
+    int iCurrent = (iStartIndex >= 0 && iStartIndex < iTriangleCount) ? iStartIndex : 0;
+    int iEntryEdge = -1;
+
+    for (int iStep = 0; iStep <= iTriangleCount; ++iStep)
+    {
+        const int* aiVertices = &pVertices[3 * iCurrent];
+        int iExitEdge = -1;
+
+        for (int i = 0; i < 3; ++i)
+        {
+            int iEdge = (iStep + i) % 3;
+            if (iEdge == iEntryEdge)
+            {
+                continue;
+            }
+
+            int iA = aiVertices[iEdge];
+            int iB = aiVertices[(iEdge + 1) % 3];
+            if (orient2d(pX[iA], pY[iA], pX[iB], pY[iB], pt.getX(), pt.getY()) < 0)
+            {
+                iExitEdge = iEdge;
+                break;
+            }
+        }
+
+        if (iExitEdge == -1)
+        {
+            return iCurrent;
+        }
+
+        int iNext = pNeighbours[3 * iCurrent + iExitEdge];
+        if (iNext == -1)
+        {
+            return -1; // The point lies outside of the mesh
+        }
+
+        // Enter the neighbour through the edge that faces the current triangle
+        iEntryEdge = -1;
+        for (int i = 0; i < 3; ++i)
+        {
+            if (pNeighbours[3 * iNext + i] == iCurrent)
+            {
+                iEntryEdge = i;
+            }
+        }
+        iCurrent = iNext;
+    }
+
+    return -1;
+}
+
+// Copies the mapped arrays into a CompactMesh
+CompactMesh MeshFile::toCompact() const
+{
+    return CompactMesh(std::vector<float>(pX, pX + iPointCount), std::vector<float>(pY, pY + iPointCount),
+                       std::vector<int>(pVertices, pVertices + 3 * iTriangleCount), std::vector<int>(pNeighbours, pNeighbours + 3 * iTriangleCount));
+}
+
+// Writes a binary mesh file: the header, then each array as one block
+bool writeMeshBinary(const std::string& sPath, const CompactMesh& mesh)
+{
+    OutputBuffer output(sPath);
+    if (!output.isOpen())
+    {
+        return false;
+    }
+
+    MeshFileHeader header;
+    std::memcpy(header.acMagic, MESH_FILE_MAGIC, sizeof(MESH_FILE_MAGIC));
+    header.uVersion = MESH_FILE_VERSION;
+    header.uHeaderSize = sizeof(MeshFileHeader);
+    header.uPointCount = mesh.getPointCount();
+    header.uTriangleCount = mesh.getTriangleCount();
+
+    uint32_t auHeaderWords[2] = { header.uVersion, header.uHeaderSize };
+    uint32_t auCountWords[4] = { static_cast<uint32_t>(header.uPointCount), static_cast<uint32_t>(header.uPointCount >> 32),
+                                 static_cast<uint32_t>(header.uTriangleCount), static_cast<uint32_t>(header.uTriangleCount >> 32) };
+    output.write(header.acMagic, sizeof(header.acMagic));
+    output.writeLittleEndian(auHeaderWords, 2);
+    output.writeLittleEndian(auCountWords, 4);
+
+    output.writeLittleEndian(mesh.getXArray().data(), mesh.getPointCount());
+    output.writeLittleEndian(mesh.getYArray().data(), mesh.getPointCount());
+    output.writeLittleEndian(mesh.getVertexArray().data(), 3 * static_cast<size_t>(mesh.getTriangleCount()));
+    output.writeLittleEndian(mesh.getNeighbourArray().data(), 3 * static_cast<size_t>(mesh.getTriangleCount()));
+
+    return output.close();
+}
+
+// Writes the .node, .ele and .neigh files of Shewchuk's Triangle. In .neigh, neighbour i lies opposite point i,
+// which is the neighbour across edge (i + 1) % 3 here.
+bool writeTriangleFiles(const std::string& sBasePath, const CompactMesh& mesh)
+{
+    const int iPointCount = mesh.getPointCount();
+    const int iTriangleCount = mesh.getTriangleCount();
+
+    OutputBuffer node(sBasePath + ".node");
+    if (!node.isOpen())
+    {
+        return false;
+    }
+    node << iPointCount << " 2 0 0\n";
+    for (int i = 0; i < iPointCount; ++i)
+    {
+        node << i << ' ' << mesh.getX(i) << ' ' << mesh.getY(i) << '\n';
+    }
+
+    OutputBuffer ele(sBasePath + ".ele");
+    if (!ele.isOpen())
+    {
+        return false;
+    }
+    ele << iTriangleCount << " 3 0\n";
+    for (int t = 0; t < iTriangleCount; ++t)
+    {
+        ele << t << ' ' << mesh.getVertex(t, 0) << ' ' << mesh.getVertex(t, 1) << ' ' << mesh.getVertex(t, 2) << '\n';
+    }
+
+    OutputBuffer neigh(sBasePath + ".neigh");
+    if (!neigh.isOpen())
+    {
+        return false;
+    }
+    neigh << iTriangleCount << " 3\n";
+    for (int t = 0; t < iTriangleCount; ++t)
+    {
+        neigh << t << ' ' << mesh.getNeighbour(t, 1) << ' ' << mesh.getNeighbour(t, 2) << ' ' << mesh.getNeighbour(t, 0) << '\n';
+    }
+
+    bool bNode = node.close();
+    bool bEle = ele.close();
+    bool bNeigh = neigh.close();
+    return bNode && bEle && bNeigh;
+}
+
+// Writes a Wavefront OBJ file with 1-based face indices
+bool writeObj(const std::string& sPath, const CompactMesh& mesh)
+{
+    OutputBuffer output(sPath);
+    if (!output.isOpen())
+    {
+        return false;
+    }
+
+    for (int i = 0; i < mesh.getPointCount(); ++i)
+    {
+        output << "v " << mesh.getX(i) << ' ' << mesh.getY(i) << " 0\n";
+    }
+
+    for (int t = 0; t < mesh.getTriangleCount(); ++t)
+    {
+        output << "f " << mesh.getVertex(t, 0) + 1 << ' ' << mesh.getVertex(t, 1) + 1 << ' ' << mesh.getVertex(t, 2) + 1 << '\n';
+    }
+
+    return output.close();
+}
+
+// Writes a binary little-endian PLY file: float x, y, z per vertex and a uchar-counted int list per face
+bool writePly(const std::string& sPath, const CompactMesh& mesh)
+{
+    OutputBuffer output(sPath);
+    if (!output.isOpen())
+    {
+        return false;
+    }
+
+    output << "ply\nformat binary_little_endian 1.0\n"
+           << "element vertex " << mesh.getPointCount() << "\nproperty float x\nproperty float y\nproperty float z\n"
+           << "element face " << mesh.getTriangleCount() << "\nproperty list uchar int vertex_indices\nend_header\n";
+
+    for (int i = 0; i < mesh.getPointCount(); ++i)
+    {
+        const float afVertex[3] = { mesh.getX(i), mesh.getY(i), 0.0f };
+        output.writeLittleEndian(afVertex, 3);
+    }
+
+    for (int t = 0; t < mesh.getTriangleCount(); ++t)
+    {
+        const unsigned char ucCount = 3;
+        output.write(&ucCount, 1);
+        output.writeLittleEndian(&mesh.getVertexArray()[3 * t], 3);
+    }
+
+    return output.close();
+}
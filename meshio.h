@@ -0,0 +1,77 @@
+#ifndef MESHIO_H
+#define MESHIO_H
+
+#include "point.h"
+#include "compactmesh.h"
+#include "mappedfile.h"
+#include <cstdint>
+#include <string>
+
+// Binary mesh file. All values are little-endian, and every block starts at a multiple of 4 bytes:
+//   header: char magic[8] = "DMESHBIN", uint32 version, uint32 header size (offset of the first block),
+//           uint64 point count, uint64 triangle count
+//   float32 x[point count], float32 y[point count]
+//   int32 vertices[3 * triangle count]  (counter-clockwise point indices)
+//   int32 neighbours[3 * triangle count]  (triangle across the edge from point i to point (i + 1) % 3, -1 on the border)
+// Readers skip header fields they do not know by starting the blocks at the header size.
+constexpr uint32_t MESH_FILE_VERSION = 1;
+
+// Class giving read-only access to a mapped binary mesh file. The arrays are used in place, so a mesh of any size
+// is ready to query as soon as it is opened.
+class MeshFile {
+
+private:
+    MappedFile file;  // Mapping of the whole file
+    int iPointCount{0}, iTriangleCount{0};  // Size of the mesh
+    const float* pX{nullptr};  // Point x coordinates
+    const float* pY{nullptr};  // Point y coordinates
+    const int* pVertices{nullptr};  // Point indices, three per triangle
+    const int* pNeighbours{nullptr};  // Neighbouring triangle indices, three per triangle
+
+public:
+    // Function to map a binary mesh file; returns false if it cannot be mapped or is not a valid mesh file
+    bool open(const std::string& sPath);
+
+    // Function to unmap the file
+    void close();
+
+    // Getters for the size of the mesh
+    int getPointCount() const;
+    int getTriangleCount() const;
+
+    // Getters for the points
+    Point getPoint(int iPointIndex) const;
+    float getX(int iPointIndex) const;
+    float getY(int iPointIndex) const;
+
+    // Getters for the point and neighbour indices of a triangle
+    int getVertex(int iTriangleIndex, int iCorner) const;
+    int getNeighbour(int iTriangleIndex, int iEdge) const;
+
+    // Getters for the mapped arrays
+    const float* getXArray() const;
+    const float* getYArray() const;
+    const int* getVertexArray() const;
+    const int* getNeighbourArray() const;
+
+    // Function to find the triangle that contains a point with a visibility walk (-1 if it is outside the mesh)
+    int findContainingTriangle(const Point& pt, int iStartIndex = 0) const;
+
+    // Function to copy the mesh into a modifiable CompactMesh
+    CompactMesh toCompact() const;
+
+};
+
+// Function to write a mesh as a binary mesh file
+bool writeMeshBinary(const std::string& sPath, const CompactMesh& mesh);
+
+// Function to write a mesh in the formats of Shewchuk's Triangle: sBasePath + ".node", ".ele" and ".neigh" (0-based)
+bool writeTriangleFiles(const std::string& sBasePath, const CompactMesh& mesh);
+
+// Function to write a mesh as a Wavefront OBJ file (z = 0)
+bool writeObj(const std::string& sPath, const CompactMesh& mesh);
+
+// Function to write a mesh as a binary little-endian PLY file (z = 0)
+bool writePly(const std::string& sPath, const CompactMesh& mesh);
+
+#endif // MESHIO_H
@@ -0,0 +1,115 @@
+#include "meshstats.h"
+
+#if DELAUNAY_ENABLE_STATS
+
+// Source of the instance ids; 0 is never handed out, so an empty thread cache matches no instance
+static std::atomic<unsigned long long> uNextCountersId{1};
+
+// Constructor with zeroed counters
+MeshCounters::MeshCounters()
+    : uId(uNextCountersId.fetch_add(1, std::memory_order_relaxed)) {}
+
+// Copy constructor: a new instance starting from the totals of the source
+MeshCounters::MeshCounters(const MeshCounters& other)
+    : MeshCounters()
+{
+    addTotals(other.snapshot());
+}
+
+// Copy assignment: replaces the counters and timings with the totals of the source
+MeshCounters& MeshCounters::operator=(const MeshCounters& other)
+{
+    if (this != &other)
+    {
+        const MeshStats stats = other.snapshot();
+        reset();
+        addTotals(stats);
+    }
+    return *this;
+}
+
+// Finds the block of the current thread, creating it on the first count, and caches it for the next counts
+MeshCounters::Block& MeshCounters::registerThread() const
+{
+    const std::thread::id idThread = std::this_thread::get_id();
+    Block* pBlock = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mtxBlocks);
+        for (const std::unique_ptr<Block>& pCandidate : vecBlocks)
+        {
+            if (pCandidate->idThread == idThread)
+            {
+                pBlock = pCandidate.get();
+                break;
+            }
+        }
+
+        if (pBlock == nullptr)
+        {
+            vecBlocks.push_back(std::make_unique<Block>());
+            pBlock = vecBlocks.back().get();
+            pBlock->idThread = idThread;
+        }
+    }
+
+    ThreadCache& cache = threadCache();
+    cache.uOwnerId = uId;
+    cache.pBlock = pBlock;
+    return *pBlock;
+}
+
+// Adds the counts of a snapshot to the current thread's block and its timings to the phases
+void MeshCounters::addTotals(const MeshStats& stats)
+{
+    add(MeshCounter::WalkSteps, stats.lWalkSteps);
+    add(MeshCounter::IncircleTests, stats.lIncircleTests);
+    add(MeshCounter::Flips, stats.lFlips);
+    add(MeshCounter::EdgeCaseSplits, stats.lEdgeCaseSplits);
+    add(MeshCounter::TrianglesAllocated, stats.lTrianglesAllocated);
+    addSeconds(MeshPhase::Build, stats.dBuildSeconds);
+    addSeconds(MeshPhase::HelperRemoval, stats.dHelperRemovalSeconds);
+    addSeconds(MeshPhase::Refinement, stats.dRefinementSeconds);
+}
+
+// Sums the counters of every thread and copies the phase timings
+MeshStats MeshCounters::snapshot() const
+{
+    std::array<long long, COUNTER_COUNT> alTotals{};
+    {
+        std::lock_guard<std::mutex> lock(mtxBlocks);
+        for (const std::unique_ptr<Block>& pBlock : vecBlocks)
+        {
+            for (int i = 0; i < COUNTER_COUNT; ++i)
+            {
+                alTotals[i] += pBlock->alCounts[i].load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    MeshStats stats;
+    stats.lWalkSteps = alTotals[static_cast<int>(MeshCounter::WalkSteps)];
+    stats.lIncircleTests = alTotals[static_cast<int>(MeshCounter::IncircleTests)];
+    stats.lFlips = alTotals[static_cast<int>(MeshCounter::Flips)];
+    stats.lEdgeCaseSplits = alTotals[static_cast<int>(MeshCounter::EdgeCaseSplits)];
+    stats.lTrianglesAllocated = alTotals[static_cast<int>(MeshCounter::TrianglesAllocated)];
+    stats.dBuildSeconds = adPhaseSeconds[static_cast<int>(MeshPhase::Build)];
+    stats.dHelperRemovalSeconds = adPhaseSeconds[static_cast<int>(MeshPhase::HelperRemoval)];
+    stats.dRefinementSeconds = adPhaseSeconds[static_cast<int>(MeshPhase::Refinement)];
+    return stats;
+}
+
+// Zeroes the counters of every thread and the phase timings; the blocks stay registered
+void MeshCounters::reset()
+{
+    std::lock_guard<std::mutex> lock(mtxBlocks);
+    for (const std::unique_ptr<Block>& pBlock : vecBlocks)
+    {
+        for (std::atomic<long long>& lCount : pBlock->alCounts)
+        {
+            lCount.store(0, std::memory_order_relaxed);
+        }
+    }
+    adPhaseSeconds.fill(0.0);
+}
+
+#endif
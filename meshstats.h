@@ -0,0 +1,157 @@
+#ifndef MESHSTATS_H
+#define MESHSTATS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// The instrumentation is compiled in unless DELAUNAY_ENABLE_STATS is defined to 0 (CMake option DELAUNAY_STATS)
+#ifndef DELAUNAY_ENABLE_STATS
+#define DELAUNAY_ENABLE_STATS 1
+#endif
+
+// Hot-path events counted by a mesh
+enum class MeshCounter {
+    WalkSteps,  // Triangles crossed by point location walks
+    IncircleTests,  // Incircle predicate evaluations
+    Flips,  // Edge flips
+    EdgeCaseSplits,  // Points inserted on an existing edge
+    TrianglesAllocated,  // Triangle slots appended to the mesh
+    Count
+};
+
+// Phases of the mesh generation whose wall time is measured
+enum class MeshPhase {
+    Build,  // buildMesh
+    HelperRemoval,  // removeHelperTriangles
+    Refinement,  // equilateralizeTriangles
+    Count
+};
+
+// Snapshot of the counters and phase timings of a mesh (all zero when the instrumentation is compiled out)
+struct MeshStats {
+    long long lWalkSteps{0};
+    long long lIncircleTests{0};
+    long long lFlips{0};
+    long long lEdgeCaseSplits{0};
+    long long lTrianglesAllocated{0};
+    double dBuildSeconds{0.0};
+    double dHelperRemovalSeconds{0.0};
+    double dRefinementSeconds{0.0};
+};
+
+#if DELAUNAY_ENABLE_STATS
+
+// Class holding the per-thread event counters and the phase timings of a mesh.
+// Every thread counts into its own cache-line sized block, found through a one-entry thread-local cache,
+// so a count is a compare and a relaxed add on memory no other thread writes. The blocks are only summed
+// when a snapshot is taken.
+class MeshCounters {
+
+private:
+    static constexpr int COUNTER_COUNT = static_cast<int>(MeshCounter::Count);
+    static constexpr int PHASE_COUNT = static_cast<int>(MeshPhase::Count);
+
+    // Counters of one thread
+    struct alignas(64) Block {
+        std::thread::id idThread;  // Thread owning the block
+        std::array<std::atomic<long long>, COUNTER_COUNT> alCounts{};  // Written by the owning thread only
+    };
+
+    // Block last used by the current thread, tagged with the id of its owner
+    struct ThreadCache {
+        unsigned long long uOwnerId;
+        Block* pBlock;
+    };
+
+    unsigned long long uId;  // Unique id of this instance, never reused, so a stale thread cache cannot match
+    mutable std::mutex mtxBlocks;  // Guards the list of blocks
+    mutable std::vector<std::unique_ptr<Block>> vecBlocks;  // One block per thread that counted
+    std::array<double, PHASE_COUNT> adPhaseSeconds{};  // Wall time spent in each phase
+
+    static ThreadCache& threadCache()
+    {
+        static thread_local ThreadCache cache{0, nullptr};
+        return cache;
+    }
+
+    // Function to find or create the block of the current thread and cache it
+    Block& registerThread() const;
+
+    // Function to add counts and timings to the current thread's block and the phase timings
+    void addTotals(const MeshStats& stats);
+
+public:
+    MeshCounters();
+
+    // Copies carry the totals of the source over
+    MeshCounters(const MeshCounters& other);
+    MeshCounters& operator=(const MeshCounters& other);
+
+    // Function to count events on the current thread
+    void add(MeshCounter eCounter, long long lAmount = 1) const
+    {
+        ThreadCache& cache = threadCache();
+        Block* pBlock = cache.uOwnerId == uId ? cache.pBlock : &registerThread();
+        std::atomic<long long>& lCount = pBlock->alCounts[static_cast<int>(eCounter)];
+        lCount.store(lCount.load(std::memory_order_relaxed) + lAmount, std::memory_order_relaxed);
+    }
+
+    // Function to add wall time to a phase
+    void addSeconds(MeshPhase ePhase, double dSeconds)
+    {
+        adPhaseSeconds[static_cast<int>(ePhase)] += dSeconds;
+    }
+
+    // Function to sum the blocks of all threads
+    MeshStats snapshot() const;
+
+    // Function to zero the counters and timings
+    void reset();
+};
+
+// Class adding the wall time of its lifetime to a phase
+class ScopedPhase {
+
+private:
+    MeshCounters& counters;
+    MeshPhase ePhase;
+    std::chrono::steady_clock::time_point start;
+
+public:
+    ScopedPhase(MeshCounters& counters, MeshPhase ePhase)
+        : counters(counters), ePhase(ePhase), start(std::chrono::steady_clock::now()) {}
+
+    ~ScopedPhase()
+    {
+        counters.addSeconds(ePhase, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+
+    ScopedPhase(const ScopedPhase&) = delete;
+    ScopedPhase& operator=(const ScopedPhase&) = delete;
+};
+
+#else
+
+// Compiled-out counters: every call is empty and inlines to nothing
+class MeshCounters {
+public:
+    void add(MeshCounter, long long = 1) const {}
+    void addSeconds(MeshPhase, double) {}
+    MeshStats snapshot() const { return MeshStats(); }
+    void reset() {}
+};
+
+// Compiled-out phase timer
+class ScopedPhase {
+public:
+    ScopedPhase(MeshCounters&, MeshPhase) {}
+};
+
+#endif
+
+#endif // MESHSTATS_H
@@ -0,0 +1,144 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Function to resolve a requested thread count (0 or less uses every hardware thread)
+inline int resolveThreadCount(int iThreadCount)
+{
+    return iThreadCount > 0 ? iThreadCount : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+}
+
+// Function to run fnBody(iBegin, iEnd, iChunk) over iCount items split into iChunkCount contiguous chunks, one thread per chunk
+template <typename Body>
+void parallelChunks(int iCount, int iChunkCount, Body fnBody)
+{
+    std::vector<std::thread> vecThreads;
+    for (int iChunk = 1; iChunk < iChunkCount; ++iChunk)
+    {
+        vecThreads.emplace_back(fnBody, static_cast<int>(static_cast<long long>(iCount) * iChunk / iChunkCount),
+                                static_cast<int>(static_cast<long long>(iCount) * (iChunk + 1) / iChunkCount), iChunk);
+    }
+    fnBody(0, static_cast<int>(static_cast<long long>(iCount) / iChunkCount), 0);
+    for (std::thread& thread : vecThreads)
+    {
+        thread.join();
+    }
+}
+
+// Fixed set of worker threads running chunked loops like parallelChunks, kept alive between loops so that
+// a caller issuing many short loops does not create and join threads for each of them
+class WorkerPool
+{
+public:
+    // Constructor starting iThreadCount - 1 workers; the calling thread runs the first chunk of every loop
+    explicit WorkerPool(int iThreadCount)
+    {
+        for (int iWorker = 1; iWorker < iThreadCount; ++iWorker)
+        {
+            vecWorkers.emplace_back(&WorkerPool::workerLoop, this, iWorker);
+        }
+    }
+
+    // Destructor stopping and joining the workers
+    ~WorkerPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mtxLoop);
+            bStop = true;
+        }
+        cvWork.notify_all();
+        for (std::thread& thread : vecWorkers)
+        {
+            thread.join();
+        }
+    }
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    // Function to return the number of threads running a loop, the caller included
+    int getThreadCount() const
+    {
+        return static_cast<int>(vecWorkers.size()) + 1;
+    }
+
+    // Function to run fnBody(iBegin, iEnd, iChunk) over iCount items split into iChunkCount contiguous chunks,
+    // with the same chunk bounds as parallelChunks; iChunkCount is capped at the thread count
+    void run(int iCount, int iChunkCount, const std::function<void(int, int, int)>& fnBody)
+    {
+        iChunkCount = std::min(iChunkCount, getThreadCount());
+        if (iChunkCount > 1)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mtxLoop);
+                pfnBody = &fnBody;
+                iLoopCount = iCount;
+                iLoopChunkCount = iChunkCount;
+                iPendingChunks = iChunkCount - 1;
+                ++uGeneration;
+            }
+            cvWork.notify_all();
+        }
+
+        fnBody(0, static_cast<int>(static_cast<long long>(iCount) / iChunkCount), 0);
+
+        if (iChunkCount > 1)
+        {
+            std::unique_lock<std::mutex> lock(mtxLoop);
+            cvDone.wait(lock, [this]() { return iPendingChunks == 0; });
+            pfnBody = nullptr;
+        }
+    }
+
+private:
+    // Waits for the loops and runs the chunk numbered like the worker, if the loop has that many chunks
+    void workerLoop(int iWorker)
+    {
+        unsigned long long uSeenGeneration = 0;
+        std::unique_lock<std::mutex> lock(mtxLoop);
+        while (true)
+        {
+            cvWork.wait(lock, [this, uSeenGeneration]() { return bStop || uGeneration != uSeenGeneration; });
+            if (bStop)
+            {
+                return;
+            }
+            uSeenGeneration = uGeneration;
+            if (iWorker >= iLoopChunkCount)
+            {
+                continue;
+            }
+
+            const std::function<void(int, int, int)>& fnBody = *pfnBody;
+            const int iBegin = static_cast<int>(static_cast<long long>(iLoopCount) * iWorker / iLoopChunkCount);
+            const int iEnd = static_cast<int>(static_cast<long long>(iLoopCount) * (iWorker + 1) / iLoopChunkCount);
+            lock.unlock();
+            fnBody(iBegin, iEnd, iWorker);
+            lock.lock();
+
+            if (--iPendingChunks == 0)
+            {
+                cvDone.notify_one();
+            }
+        }
+    }
+
+    std::vector<std::thread> vecWorkers;  // Worker threads, the k-th one running chunk k + 1
+    std::mutex mtxLoop;  // Guards the loop description and the counters below
+    std::condition_variable cvWork;  // Signalled when a loop starts or the pool stops
+    std::condition_variable cvDone;  // Signalled when the last worker chunk of a loop finishes
+    const std::function<void(int, int, int)>* pfnBody{nullptr};  // Body of the current loop
+    int iLoopCount{0};  // Item count of the current loop
+    int iLoopChunkCount{0};  // Chunk count of the current loop
+    int iPendingChunks{0};  // Worker chunks of the current loop still running
+    unsigned long long uGeneration{0};  // Number of loops started, used by the workers to detect a new one
+    bool bStop{false};  // Whether the workers must exit
+};
+
+#endif // PARALLEL_H
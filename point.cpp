@@ -48,6 +48,15 @@ double Point::findDistance(const Point& p2) const
     return dDistance;
 }
 
+// Function to find the squared distance to another point (no square root)
+double Point::findSquaredDistance(const Point& p2) const
+{
+    double dx_t = static_cast<double>(p2.getX()) - fx;
+    double dy_t = static_cast<double>(p2.getY()) - fy;
+
+    return dx_t * dx_t + dy_t * dy_t;
+}
+
 // Function to find the slope to another point
 double Point::findSlope(const Point& p2) const
 {
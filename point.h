@@ -29,6 +29,9 @@ public:
     // Function to find the distance between another point
     double findDistance(const Point& p2) const;
 
+    // Function to find the squared distance to another point
+    double findSquaredDistance(const Point& p2) const;
+
     // Function to find the slope to another point
     double findSlope(const Point& p2) const;
 
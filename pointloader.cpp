@@ -0,0 +1,195 @@
+#include "pointloader.h"
+#include "parallel.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <type_traits>
+#include <utility>
+
+static_assert(sizeof(Point) == 2 * sizeof(float) && std::is_standard_layout<Point>::value,
+              "Point must be laid out as two floats to be read in place from a binary point file");
+
+// Text chunks smaller than this are not worth a thread of their own
+static const size_t MIN_PARALLEL_TEXT_BYTES = 1 << 20;
+
+// Maps a raw binary point file
+bool PointFile::open(const std::string& sPath)
+{
+    if (!file.open(sPath))
+    {
+        return false;
+    }
+
+    if (file.size() % sizeof(Point) != 0)
+    {
+        std::cerr << sPath << " is not a binary point file: its size is not a multiple of " << sizeof(Point) << " bytes." << std::endl;
+        file.close();
+        return false;
+    }
+
+    return true;
+}
+
+// Unmaps the file
+void PointFile::close()
+{
+    file.close();
+}
+
+// Returns the first point of the file
+const Point* PointFile::data() const
+{
+    return reinterpret_cast<const Point*>(file.data());
+}
+
+// Returns the number of points in the file
+size_t PointFile::size() const
+{
+    return file.size() / sizeof(Point);
+}
+
+// Returns the first point of the file
+const Point* PointFile::begin() const
+{
+    return data();
+}
+
+// Returns the end of the points of the file
+const Point* PointFile::end() const
+{
+    return data() + size();
+}
+
+// Checks whether a character separates two columns
+static bool isSeparator(char c)
+{
+    return c == ' ' || c == '\t' || c == ',' || c == ';' || c == '\r';
+}
+
+// Parses the lines of [pBegin, pEnd), which starts at a line boundary, appending the points and counting the skipped lines
+static void parseLines(const char* pBegin, const char* pEnd, std::vector<Point>& vecPt, size_t& uSkippedLines)
+{
+    const char* p = pBegin;
+    while (p < pEnd)
+    {
+        const char* pLineEnd = static_cast<const char*>(std::memchr(p, '\n', pEnd - p));
+        if (!pLineEnd)
+        {
+            pLineEnd = pEnd;
+        }
+
+        while (p < pLineEnd && isSeparator(*p)) ++p;
+
+        if (p < pLineEnd)
+        {
+            float fX, fY;
+            std::from_chars_result result = std::from_chars(p, pLineEnd, fX);
+            bool bParsed = result.ec == std::errc() && result.ptr < pLineEnd && isSeparator(*result.ptr);
+            if (bParsed)
+            {
+                p = result.ptr;
+                while (p < pLineEnd && isSeparator(*p)) ++p;
+                result = std::from_chars(p, pLineEnd, fY);
+                bParsed = result.ec == std::errc() && (result.ptr == pLineEnd || isSeparator(*result.ptr));
+            }
+
+            if (bParsed)
+            {
+                vecPt.emplace_back(fX, fY);
+            }
+            else
+            {
+                ++uSkippedLines;
+            }
+        }
+
+        p = pLineEnd + 1;
+    }
+}
+
+// Parses points from text. Every thread parses its own chunk into a private vector, and the chunks are then copied in order
+// into the result, so the points keep the order of the lines.
+std::vector<Point> parsePointText(const char* pBegin, const char* pEnd, int iThreadCount, size_t* puSkippedLines)
+{
+    const size_t uBytes = pEnd - pBegin;
+    const int iChunkCount = static_cast<int>(std::max<size_t>(1, std::min<size_t>(resolveThreadCount(iThreadCount), uBytes / MIN_PARALLEL_TEXT_BYTES)));
+
+    // Chunk boundaries, moved forward to the start of the next line
+    std::vector<const char*> vecBounds(iChunkCount + 1);
+    vecBounds[0] = pBegin;
+    vecBounds[iChunkCount] = pEnd;
+    for (int iChunk = 1; iChunk < iChunkCount; ++iChunk)
+    {
+        const char* p = std::max(pBegin + uBytes * iChunk / iChunkCount, vecBounds[iChunk - 1]);
+        const char* pNewline = static_cast<const char*>(std::memchr(p, '\n', pEnd - p));
+        vecBounds[iChunk] = pNewline ? pNewline + 1 : pEnd;
+    }
+
+    std::vector<std::vector<Point>> vecChunkPoints(iChunkCount);
+    std::vector<size_t> vecChunkSkipped(iChunkCount, 0);
+    parallelChunks(iChunkCount, iChunkCount, [&](int iBegin, int iEnd, int) {
+        for (int iChunk = iBegin; iChunk < iEnd; ++iChunk)
+        {
+            // Text points take at least 4 bytes, usually well over 16
+            vecChunkPoints[iChunk].reserve((vecBounds[iChunk + 1] - vecBounds[iChunk]) / 16);
+            parseLines(vecBounds[iChunk], vecBounds[iChunk + 1], vecChunkPoints[iChunk], vecChunkSkipped[iChunk]);
+        }
+    });
+
+    if (iChunkCount == 1)
+    {
+        if (puSkippedLines) *puSkippedLines = vecChunkSkipped[0];
+        return std::move(vecChunkPoints[0]);
+    }
+
+    std::vector<size_t> vecOffsets(iChunkCount + 1, 0);
+    for (int iChunk = 0; iChunk < iChunkCount; ++iChunk)
+    {
+        vecOffsets[iChunk + 1] = vecOffsets[iChunk] + vecChunkPoints[iChunk].size();
+    }
+
+    std::vector<Point> vecPt(vecOffsets[iChunkCount]);
+    parallelChunks(iChunkCount, iChunkCount, [&](int iBegin, int iEnd, int) {
+        for (int iChunk = iBegin; iChunk < iEnd; ++iChunk)
+        {
+            std::copy(vecChunkPoints[iChunk].begin(), vecChunkPoints[iChunk].end(), vecPt.begin() + vecOffsets[iChunk]);
+            std::vector<Point>().swap(vecChunkPoints[iChunk]);
+        }
+    });
+
+    if (puSkippedLines)
+    {
+        *puSkippedLines = 0;
+        for (size_t uSkipped : vecChunkSkipped) *puSkippedLines += uSkipped;
+    }
+    return vecPt;
+}
+
+// Loads a text point file
+bool loadPointText(const std::string& sPath, std::vector<Point>& vecPt, int iThreadCount)
+{
+    MappedFile file;
+    if (!file.open(sPath))
+    {
+        return false;
+    }
+
+    vecPt = parsePointText(file.data(), file.data() + file.size(), iThreadCount);
+    return true;
+}
+
+// Writes points as a raw binary point file
+bool writePointBinary(const std::string& sPath, const std::vector<Point>& vecPt)
+{
+    std::ofstream file(sPath, std::ios::binary);
+    if (!file)
+    {
+        std::cerr << "Could not create " << sPath << "." << std::endl;
+        return false;
+    }
+
+    file.write(reinterpret_cast<const char*>(vecPt.data()), vecPt.size() * sizeof(Point));
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,43 @@
+#ifndef POINTLOADER_H
+#define POINTLOADER_H
+
+#include "point.h"
+#include "mappedfile.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Class giving zero-copy access to a raw binary point file: float32 x/y pairs in native byte order, 8 bytes per point.
+// The mapped bytes are laid out exactly like an array of Point, so the points are read straight from the page cache.
+class PointFile {
+
+private:
+    MappedFile file;  // Mapping of the whole file
+
+public:
+    // Function to map a point file; returns false if it cannot be mapped or its size is not a multiple of 8 bytes
+    bool open(const std::string& sPath);
+
+    // Function to unmap the file
+    void close();
+
+    // Getters for the mapped points
+    const Point* data() const;
+    size_t size() const;
+    const Point* begin() const;
+    const Point* end() const;
+
+};
+
+// Function to parse points from CSV or XYZ text, one point per line: x and y separated by commas, semicolons or
+// whitespace, further columns ignored. Lines that do not start with two numbers (headers, comments) are skipped.
+// The text is split at line boundaries and parsed with std::from_chars on up to iThreadCount threads (0 uses every hardware thread).
+std::vector<Point> parsePointText(const char* pBegin, const char* pEnd, int iThreadCount = 0, size_t* puSkippedLines = nullptr);
+
+// Function to load a CSV or XYZ text file by mapping it and parsing it in parallel; returns false if it cannot be mapped
+bool loadPointText(const std::string& sPath, std::vector<Point>& vecPt, int iThreadCount = 0);
+
+// Function to write points as a raw binary point file
+bool writePointBinary(const std::string& sPath, const std::vector<Point>& vecPt);
+
+#endif // POINTLOADER_H
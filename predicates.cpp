@@ -0,0 +1,373 @@
+#include "predicates.h"
+#include <cmath>
+
+// Expansions are arrays of non-overlapping doubles stored from the least to the most significant
+// component; their exact sum is the represented value.
+
+// Machine epsilon of double precision arithmetic (2^-53)
+static const double EPSILON = std::ldexp(1.0, -53);
+
+// Splitter used to split a double into two non-overlapping halves (2^27 + 1)
+static const double SPLITTER = std::ldexp(1.0, 27) + 1.0;
+
+// Relative error bounds of the double precision determinants
+static const double ORIENT_ERROR_BOUND = (3.0 + 16.0 * EPSILON) * EPSILON;
+static const double INCIRCLE_ERROR_BOUND = (10.0 + 96.0 * EPSILON) * EPSILON;
+
+// Maximum length of the expansions produced by the exact incircle test
+static const int MAX_EXPANSION = 2048;
+
+// Computes a + b = dX + dY exactly
+static inline void twoSum(double dA, double dB, double& dX, double& dY)
+{
+    dX = dA + dB;
+    double dBVirtual = dX - dA;
+    double dAVirtual = dX - dBVirtual;
+    double dBRoundoff = dB - dBVirtual;
+    double dARoundoff = dA - dAVirtual;
+    dY = dARoundoff + dBRoundoff;
+}
+
+// Computes a - b = dX + dY exactly
+static inline void twoDiff(double dA, double dB, double& dX, double& dY)
+{
+    dX = dA - dB;
+    double dBVirtual = dA - dX;
+    double dAVirtual = dX + dBVirtual;
+    double dBRoundoff = dBVirtual - dB;
+    double dARoundoff = dA - dAVirtual;
+    dY = dARoundoff + dBRoundoff;
+}
+
+// Splits a double into two halves of at most 26 significant bits each
+static inline void split(double dA, double& dHigh, double& dLow)
+{
+    double dC = SPLITTER * dA;
+    double dBig = dC - dA;
+    dHigh = dC - dBig;
+    dLow = dA - dHigh;
+}
+
+// Computes a * b = dX + dY exactly
+static inline void twoProduct(double dA, double dB, double& dX, double& dY)
+{
+    dX = dA * dB;
+
+    double dAHigh, dALow, dBHigh, dBLow;
+    split(dA, dAHigh, dALow);
+    split(dB, dBHigh, dBLow);
+
+    double dErr1 = dX - (dAHigh * dBHigh);
+    double dErr2 = dErr1 - (dALow * dBHigh);
+    double dErr3 = dErr2 - (dAHigh * dBLow);
+    dY = (dALow * dBLow) - dErr3;
+}
+
+// Sums two expansions, eliminating zero components; returns the length of adH
+static int expansionSum(int iELength, const double* adE, int iFLength, const double* adF, double* adH)
+{
+    if (iELength == 0 || iFLength == 0)
+    {
+        const double* adSource = iELength == 0 ? adF : adE;
+        int iLength = iELength == 0 ? iFLength : iELength;
+        for (int i = 0; i < iLength; ++i)
+        {
+            adH[i] = adSource[i];
+        }
+        return iLength;
+    }
+
+    double dQ, dQNew, dH;
+    int iE = 0, iF = 0, iH = 0;
+
+    double dENow = adE[0];
+    double dFNow = adF[0];
+
+    // Merge the components by increasing magnitude
+    if ((dFNow > dENow) == (dFNow > -dENow))
+    {
+        dQ = dENow;
+        dENow = ++iE < iELength ? adE[iE] : 0.0;
+    }
+    else
+    {
+        dQ = dFNow;
+        dFNow = ++iF < iFLength ? adF[iF] : 0.0;
+    }
+
+    while (iE < iELength && iF < iFLength)
+    {
+        if ((dFNow > dENow) == (dFNow > -dENow))
+        {
+            twoSum(dQ, dENow, dQNew, dH);
+            dENow = ++iE < iELength ? adE[iE] : 0.0;
+        }
+        else
+        {
+            twoSum(dQ, dFNow, dQNew, dH);
+            dFNow = ++iF < iFLength ? adF[iF] : 0.0;
+        }
+
+        dQ = dQNew;
+        if (dH != 0.0)
+        {
+            adH[iH++] = dH;
+        }
+    }
+
+    while (iE < iELength)
+    {
+        twoSum(dQ, dENow, dQNew, dH);
+        dENow = ++iE < iELength ? adE[iE] : 0.0;
+        dQ = dQNew;
+        if (dH != 0.0)
+        {
+            adH[iH++] = dH;
+        }
+    }
+
+    while (iF < iFLength)
+    {
+        twoSum(dQ, dFNow, dQNew, dH);
+        dFNow = ++iF < iFLength ? adF[iF] : 0.0;
+        dQ = dQNew;
+        if (dH != 0.0)
+        {
+            adH[iH++] = dH;
+        }
+    }
+
+    if (dQ != 0.0 || iH == 0)
+    {
+        adH[iH++] = dQ;
+    }
+
+    return iH;
+}
+
+// Multiplies an expansion by a double, eliminating zero components; returns the length of adH
+static int scaleExpansion(int iELength, const double* adE, double dB, double* adH)
+{
+    if (iELength == 0)
+    {
+        return 0;
+    }
+
+    double dQ, dSum, dH, dProduct1, dProduct0;
+    int iH = 0;
+
+    twoProduct(adE[0], dB, dQ, dH);
+    if (dH != 0.0)
+    {
+        adH[iH++] = dH;
+    }
+
+    for (int i = 1; i < iELength; ++i)
+    {
+        twoProduct(adE[i], dB, dProduct1, dProduct0);
+        twoSum(dQ, dProduct0, dSum, dH);
+        if (dH != 0.0)
+        {
+            adH[iH++] = dH;
+        }
+
+        twoSum(dProduct1, dSum, dQ, dH);
+        if (dH != 0.0)
+        {
+            adH[iH++] = dH;
+        }
+    }
+
+    if (dQ != 0.0 || iH == 0)
+    {
+        adH[iH++] = dQ;
+    }
+
+    return iH;
+}
+
+// Multiplies two expansions; returns the length of adH
+static int multiplyExpansion(int iELength, const double* adE, int iFLength, const double* adF, double* adH)
+{
+    double adScaled[MAX_EXPANSION];
+    double adSum[MAX_EXPANSION];
+    int iHLength = 0;
+
+    for (int i = 0; i < iFLength; ++i)
+    {
+        int iScaledLength = scaleExpansion(iELength, adE, adF[i], adScaled);
+        int iSumLength = expansionSum(iHLength, adH, iScaledLength, adScaled, adSum);
+
+        for (int j = 0; j < iSumLength; ++j)
+        {
+            adH[j] = adSum[j];
+        }
+        iHLength = iSumLength;
+    }
+
+    return iHLength;
+}
+
+// Negates an expansion in place
+static void negateExpansion(int iELength, double* adE)
+{
+    for (int i = 0; i < iELength; ++i)
+    {
+        adE[i] = -adE[i];
+    }
+}
+
+// Computes e1 * f1 - e2 * f2 for two-component expansions; returns the length of adH
+static int crossExpansion(const double* adE1, const double* adF1, const double* adE2, const double* adF2, double* adH)
+{
+    double adLeft[8], adRight[8];
+    int iLeftLength = multiplyExpansion(2, adE1, 2, adF1, adLeft);
+    int iRightLength = multiplyExpansion(2, adE2, 2, adF2, adRight);
+    negateExpansion(iRightLength, adRight);
+
+    return expansionSum(iLeftLength, adLeft, iRightLength, adRight, adH);
+}
+
+// Computes the orientation determinant exactly
+double orient2dExact(double dAx, double dAy, double dBx, double dBy, double dCx, double dCy)
+{
+    // Exact coordinate differences as two-component expansions
+    double adAcx[2], adAcy[2], adBcx[2], adBcy[2];
+    twoDiff(dAx, dCx, adAcx[1], adAcx[0]);
+    twoDiff(dAy, dCy, adAcy[1], adAcy[0]);
+    twoDiff(dBx, dCx, adBcx[1], adBcx[0]);
+    twoDiff(dBy, dCy, adBcy[1], adBcy[0]);
+
+    double adDet[16];
+    int iLength = crossExpansion(adAcx, adBcy, adAcy, adBcx, adDet);
+
+    return adDet[iLength - 1];
+}
+
+// Computes the orientation of C relative to the directed line A->B
+double orient2d(double dAx, double dAy, double dBx, double dBy, double dCx, double dCy)
+{
+    double dDetLeft = (dAx - dCx) * (dBy - dCy);
+    double dDetRight = (dAy - dCy) * (dBx - dCx);
+    double dDet = dDetLeft - dDetRight;
+    double dDetSum;
+
+    // When the two products have different signs the subtraction cannot cancel
+    if (dDetLeft > 0.0)
+    {
+        if (dDetRight <= 0.0)
+        {
+            return dDet;
+        }
+        dDetSum = dDetLeft + dDetRight;
+    }
+    else if (dDetLeft < 0.0)
+    {
+        if (dDetRight >= 0.0)
+        {
+            return dDet;
+        }
+        dDetSum = -dDetLeft - dDetRight;
+    }
+    else
+    {
+        return dDet;
+    }
+
+    double dErrorBound = ORIENT_ERROR_BOUND * dDetSum;
+    if (dDet >= dErrorBound || -dDet >= dErrorBound)
+    {
+        return dDet;
+    }
+
+    return orient2dExact(dAx, dAy, dBx, dBy, dCx, dCy);
+}
+
+// Computes the orientation of C relative to the directed line A->B
+double orient2d(const Point& ptA, const Point& ptB, const Point& ptC)
+{
+    return orient2d(ptA.getX(), ptA.getY(), ptB.getX(), ptB.getY(), ptC.getX(), ptC.getY());
+}
+
+// Computes the incircle determinant exactly
+double incircleExact(double dAx, double dAy, double dBx, double dBy, double dCx, double dCy, double dDx, double dDy)
+{
+    // Exact coordinate differences as two-component expansions
+    double adAdx[2], adAdy[2], adBdx[2], adBdy[2], adCdx[2], adCdy[2];
+    twoDiff(dAx, dDx, adAdx[1], adAdx[0]);
+    twoDiff(dAy, dDy, adAdy[1], adAdy[0]);
+    twoDiff(dBx, dDx, adBdx[1], adBdx[0]);
+    twoDiff(dBy, dDy, adBdy[1], adBdy[0]);
+    twoDiff(dCx, dDx, adCdx[1], adCdx[0]);
+    twoDiff(dCy, dDy, adCdy[1], adCdy[0]);
+
+    const double* aadX[3] = { adAdx, adBdx, adCdx };
+    const double* aadY[3] = { adAdy, adBdy, adCdy };
+
+    double adDet[MAX_EXPANSION];
+    int iDetLength = 0;
+
+    // det = sum over the rows of lift(row) * cross(next row, row after that)
+    for (int i = 0; i < 3; ++i)
+    {
+        int iNext = (i + 1) % 3;
+        int iLast = (i + 2) % 3;
+
+        double adXX[8], adYY[8], adLift[16];
+        int iXXLength = multiplyExpansion(2, aadX[i], 2, aadX[i], adXX);
+        int iYYLength = multiplyExpansion(2, aadY[i], 2, aadY[i], adYY);
+        int iLiftLength = expansionSum(iXXLength, adXX, iYYLength, adYY, adLift);
+
+        double adCross[16];
+        int iCrossLength = crossExpansion(aadX[iNext], aadY[iLast], aadX[iLast], aadY[iNext], adCross);
+
+        double adTerm[512];
+        int iTermLength = multiplyExpansion(iLiftLength, adLift, iCrossLength, adCross, adTerm);
+
+        double adSum[MAX_EXPANSION];
+        int iSumLength = expansionSum(iDetLength, adDet, iTermLength, adTerm, adSum);
+        for (int j = 0; j < iSumLength; ++j)
+        {
+            adDet[j] = adSum[j];
+        }
+        iDetLength = iSumLength;
+    }
+
+    return adDet[iDetLength - 1];
+}
+
+// Tests D against the circle through A, B, C
+double incircle(double dAx, double dAy, double dBx, double dBy, double dCx, double dCy, double dDx, double dDy)
+{
+    double dAdx = dAx - dDx, dBdx = dBx - dDx, dCdx = dCx - dDx;
+    double dAdy = dAy - dDy, dBdy = dBy - dDy, dCdy = dCy - dDy;
+
+    double dBdxCdy = dBdx * dCdy, dCdxBdy = dCdx * dBdy;
+    double dALift = dAdx * dAdx + dAdy * dAdy;
+
+    double dCdxAdy = dCdx * dAdy, dAdxCdy = dAdx * dCdy;
+    double dBLift = dBdx * dBdx + dBdy * dBdy;
+
+    double dAdxBdy = dAdx * dBdy, dBdxAdy = dBdx * dAdy;
+    double dCLift = dCdx * dCdx + dCdy * dCdy;
+
+    double dDet = dALift * (dBdxCdy - dCdxBdy) + dBLift * (dCdxAdy - dAdxCdy) + dCLift * (dAdxBdy - dBdxAdy);
+
+    double dPermanent = (std::fabs(dBdxCdy) + std::fabs(dCdxBdy)) * dALift +
+                        (std::fabs(dCdxAdy) + std::fabs(dAdxCdy)) * dBLift +
+                        (std::fabs(dAdxBdy) + std::fabs(dBdxAdy)) * dCLift;
+
+    double dErrorBound = INCIRCLE_ERROR_BOUND * dPermanent;
+    if (dDet > dErrorBound || -dDet > dErrorBound)
+    {
+        return dDet;
+    }
+
+    return incircleExact(dAx, dAy, dBx, dBy, dCx, dCy, dDx, dDy);
+}
+
+// Tests D against the circle through A, B, C
+double incircle(const Point& ptA, const Point& ptB, const Point& ptC, const Point& ptD)
+{
+    return incircle(ptA.getX(), ptA.getY(), ptB.getX(), ptB.getY(), ptC.getX(), ptC.getY(), ptD.getX(), ptD.getY());
+}
@@ -0,0 +1,27 @@
+#ifndef PREDICATES_H
+#define PREDICATES_H
+
+#include "point.h"
+
+// Geometric predicates in the style of Shewchuk's robust predicates.
+// Each test first evaluates the determinant in double precision and checks it against a
+// forward error bound; only when the sign is uncertain is the determinant recomputed exactly
+// with floating-point expansion arithmetic. The sign of the result is always correct.
+
+// Function to compute the orientation of C relative to the directed line A->B
+// (positive if A, B, C are counter-clockwise, negative if clockwise, zero if collinear)
+double orient2d(double dAx, double dAy, double dBx, double dBy, double dCx, double dCy);
+double orient2d(const Point& ptA, const Point& ptB, const Point& ptC);
+
+// Function to test D against the circle through A, B, C
+// (positive if D is inside when A, B, C are counter-clockwise, negative if outside, zero if cocircular)
+double incircle(double dAx, double dAy, double dBx, double dBy, double dCx, double dCy, double dDx, double dDy);
+double incircle(const Point& ptA, const Point& ptB, const Point& ptC, const Point& ptD);
+
+// Function to compute the orientation determinant exactly (slow path of orient2d)
+double orient2dExact(double dAx, double dAy, double dBx, double dBy, double dCx, double dCy);
+
+// Function to compute the incircle determinant exactly (slow path of incircle)
+double incircleExact(double dAx, double dAy, double dBx, double dBy, double dCx, double dCy, double dDx, double dDy);
+
+#endif // PREDICATES_H
@@ -0,0 +1,84 @@
+#define _USE_MATH_DEFINES
+
+#include "quality.h"
+#include <cmath>
+
+// Precomputes the squared sine and cosine of a threshold angle
+AngleThreshold::AngleThreshold(double dDegrees)
+    : dDegrees(dDegrees)
+{
+    double dRadians = dDegrees * M_PI / 180.0;
+    dSin2 = std::sin(dRadians) * std::sin(dRadians);
+    dCos2 = std::cos(dRadians) * std::cos(dRadians);
+}
+
+// Scores the angle at C: sin^2 = cross^2 / (|CA|^2 |CB|^2), and the dot product tells whether the angle is acute
+double angleScore(double dAx, double dAy, double dBx, double dBy, double dCx, double dCy)
+{
+    double dUx = dAx - dCx, dUy = dAy - dCy;
+    double dVx = dBx - dCx, dVy = dBy - dCy;
+
+    double dCross = dUx * dVy - dUy * dVx;
+    double dDot = dUx * dVx + dUy * dVy;
+    double dLengths = (dUx * dUx + dUy * dUy) * (dVx * dVx + dVy * dVy);
+
+    return dDot > 0.0 ? (dCross * dCross) / dLengths : 1.0;
+}
+
+// Checks whether the angle at C is below a threshold: the angle must be acute and cos^2 must exceed the threshold's
+bool isAngleBelow(double dAx, double dAy, double dBx, double dBy, double dCx, double dCy, const AngleThreshold& threshold)
+{
+    double dUx = dAx - dCx, dUy = dAy - dCy;
+    double dVx = dBx - dCx, dVy = dBy - dCy;
+
+    double dDot = dUx * dVx + dUy * dVy;
+    double dLengths = (dUx * dUx + dUy * dUy) * (dVx * dVx + dVy * dVy);
+
+    return dDot > 0.0 && dDot * dDot > threshold.dCos2 * dLengths;
+}
+
+// Scores a specified angle of a triangle; angle i lies at the corner opposite edge i, which is point (i + 2) % 3
+double angleScore(const Triangle& triangle, int iAngle)
+{
+    const Point ptA = triangle.getPoint(iAngle);
+    const Point ptB = triangle.getPoint((iAngle + 1) % 3);
+    const Point ptC = triangle.getPoint((iAngle + 2) % 3);
+    return angleScore(ptA.getX(), ptA.getY(), ptB.getX(), ptB.getY(), ptC.getX(), ptC.getY());
+}
+
+// Checks whether a specified angle of a triangle is below a threshold, with the corners taken as in angleScore
+bool isAngleBelow(const Triangle& triangle, int iAngle, const AngleThreshold& threshold)
+{
+    const Point ptA = triangle.getPoint(iAngle);
+    const Point ptB = triangle.getPoint((iAngle + 1) % 3);
+    const Point ptC = triangle.getPoint((iAngle + 2) % 3);
+    return isAngleBelow(ptA.getX(), ptA.getY(), ptB.getX(), ptB.getY(), ptC.getX(), ptC.getY(), threshold);
+}
+
+// Scores the three angles of a range of triangles.
+// The loop body is branch-free and reads each array contiguously so the compiler can vectorize it.
+void angleScoreBatch(const double* const pdX[3], const double* const pdY[3], int iCount, double* const pdScore[3])
+{
+    for (int iAngle = 0; iAngle < 3; ++iAngle)
+    {
+        const double* pdAx = pdX[iAngle];
+        const double* pdAy = pdY[iAngle];
+        const double* pdBx = pdX[(iAngle + 1) % 3];
+        const double* pdBy = pdY[(iAngle + 1) % 3];
+        const double* pdCx = pdX[(iAngle + 2) % 3];
+        const double* pdCy = pdY[(iAngle + 2) % 3];
+        double* pdOut = pdScore[iAngle];
+
+        for (int k = 0; k < iCount; ++k)
+        {
+            double dUx = pdAx[k] - pdCx[k], dUy = pdAy[k] - pdCy[k];
+            double dVx = pdBx[k] - pdCx[k], dVy = pdBy[k] - pdCy[k];
+
+            double dCross = dUx * dVy - dUy * dVx;
+            double dDot = dUx * dVx + dUy * dVy;
+            double dLengths = (dUx * dUx + dUy * dUy) * (dVx * dVx + dVy * dVy);
+
+            pdOut[k] = dDot > 0.0 ? (dCross * dCross) / dLengths : 1.0;
+        }
+    }
+}
@@ -0,0 +1,38 @@
+#ifndef QUALITY_H
+#define QUALITY_H
+
+#include "triangle.h"
+
+// Trigonometry-free triangle quality kernel.
+// Angles are never computed: the angle at a corner is scored from the cross and dot products of its two edges
+// and their squared lengths, and compared against the squared sine and cosine of the threshold computed once.
+// Angle i of a triangle is the one opposite edge i, as returned by Triangle::getAng.
+
+// Squared sine and cosine of an angle threshold (in degrees, at most 90)
+struct AngleThreshold {
+    double dDegrees;  // Threshold angle
+    double dSin2;  // Squared sine of the threshold
+    double dCos2;  // Squared cosine of the threshold
+
+    // Constructor to precompute the squared sine and cosine of a threshold angle
+    explicit AngleThreshold(double dDegrees);
+};
+
+// Function to score the angle at C between the edges to A and B
+// (squared sine of the angle when it is acute, 1 otherwise, so the score grows with the angle up to 90 degrees)
+double angleScore(double dAx, double dAy, double dBx, double dBy, double dCx, double dCy);
+
+// Function to check whether the angle at C between the edges to A and B is below a threshold
+bool isAngleBelow(double dAx, double dAy, double dBx, double dBy, double dCx, double dCy, const AngleThreshold& threshold);
+
+// Function to score a specified angle of a triangle
+double angleScore(const Triangle& triangle, int iAngle);
+
+// Function to check whether a specified angle of a triangle is below a threshold
+bool isAngleBelow(const Triangle& triangle, int iAngle, const AngleThreshold& threshold);
+
+// Function to score the three angles of a range of triangles given as coordinate arrays
+// (corner i of triangle k is (pdX[i][k], pdY[i][k]); score i of triangle k is written to pdScore[i][k])
+void angleScoreBatch(const double* const pdX[3], const double* const pdY[3], int iCount, double* const pdScore[3]);
+
+#endif // QUALITY_H
@@ -0,0 +1,192 @@
+#include "mesh.h"
+#include "predicates.h"
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <vector>
+
+static const int BUILD_POINTS = 20000;  // Points triangulated before the removals
+static const int REMOVED_POINTS = 3000;  // Random vertices removed from each mesh
+static const int REINSERTED_POINTS = 4000;  // Points inserted after the removals, enough to use up every free slot
+
+// Counts the defects of a mesh: slots whose index is wrong, free slots that still have neighbours, corners that do not
+// match the points, neighbour corners that are not symmetric or lead to a free slot, and edges whose opposite point
+// lies inside the circumcircle
+static int countDefects(const Mesh& mesh)
+{
+    const Span<const Point> spanPoints = mesh.getShapeView();
+    const Span<const Triangle> spanTriangles = mesh.getTriView();
+    int iDefects = 0;
+    for (size_t i = 0; i < spanTriangles.size(); ++i)
+    {
+        const Triangle& triangle = spanTriangles[i];
+        if (triangle.getIndex() != static_cast<int>(i))
+        {
+            ++iDefects;
+        }
+        if (triangle.isFree())
+        {
+            for (int j = 0; j < 3; ++j)
+            {
+                iDefects += triangle.getNeighbourCorner(j) != -1;
+            }
+            continue;
+        }
+
+        for (int j = 0; j < 3; ++j)
+        {
+            const Point& ptCorner = spanPoints[triangle.getPointIndex(j)];
+            if (ptCorner.getX() != triangle.getPoint(j).getX() || ptCorner.getY() != triangle.getPoint(j).getY())
+            {
+                ++iDefects;
+            }
+
+            const int iCorner = triangle.getNeighbourCorner(j);
+            if (iCorner < 0)
+            {
+                continue;
+            }
+            const Triangle& neighbour = spanTriangles[iCorner / 3];
+            if (neighbour.isFree() || neighbour.getNeighbourCorner(iCorner % 3) != static_cast<int>(3 * i + j))
+            {
+                ++iDefects;
+                continue;
+            }
+
+            const Point& ptOpposite = spanPoints[neighbour.getPointIndex((iCorner % 3 + 2) % 3)];
+            if (incircle(triangle.getPoint(0), triangle.getPoint(1), triangle.getPoint(2), ptOpposite) > 0)
+            {
+                ++iDefects;
+            }
+        }
+    }
+    return iDefects;
+}
+
+// Counts the slots rewritten or relinked since the snapshot that are missing from the sorted changed list
+static int countUnreported(const Mesh& mesh, const std::vector<Triangle>& vecBefore, const std::vector<int>& vecChanged)
+{
+    const Span<const Triangle> spanTriangles = mesh.getTriView();
+    int iUnreported = 0;
+    for (size_t i = 0; i < spanTriangles.size(); ++i)
+    {
+        bool bChanged = i >= vecBefore.size();
+        for (int j = 0; j < 3 && !bChanged; ++j)
+        {
+            bChanged = spanTriangles[i].getPointIndex(j) != vecBefore[i].getPointIndex(j)
+                       || spanTriangles[i].getNeighbourCorner(j) != vecBefore[i].getNeighbourCorner(j);
+        }
+        if (bChanged && !std::binary_search(vecChanged.begin(), vecChanged.end(), static_cast<int>(i)))
+        {
+            ++iUnreported;
+        }
+    }
+    return iUnreported;
+}
+
+// Counts the free slots of a mesh
+static int countFreeSlots(const Mesh& mesh)
+{
+    int iFree = 0;
+    for (const Triangle& triangle : mesh.getTriView())
+    {
+        iFree += triangle.isFree();
+    }
+    return iFree;
+}
+
+// Builds a mesh, removes random vertices from it and checks that every removal succeeds, that the reported slots cover
+// every slot changed, that the mesh is still Delaunay, and that a following insertPoints fills the free slots first
+static int testRemovePoint(InsertionEngine eEngine, bool bGrid)
+{
+    const char* pszConfig = eEngine == InsertionEngine::BowyerWatson ? (bGrid ? "BowyerWatson, grid" : "BowyerWatson, no grid")
+                                                                     : (bGrid ? "SplitAndFlip, grid" : "SplitAndFlip, no grid");
+
+    std::mt19937 gen(11);
+    std::uniform_real_distribution<float> dis(0.0f, 1000.0f);
+    std::vector<Point> vecPt;
+    for (int i = 0; i < BUILD_POINTS; ++i)
+    {
+        vecPt.emplace_back(dis(gen), dis(gen));
+    }
+
+    Mesh mesh(vecPt);
+    mesh.setInsertionEngine(eEngine);
+    mesh.setTriVector({ mesh.superTriangle() });
+    mesh.buildMesh();
+    if (bGrid)
+    {
+        mesh.enableGridIndex();
+    }
+
+    // Distinct random vertices; the super triangle keeps them all inside the mesh, so each of them can be removed
+    std::vector<int> vecCandidates(mesh.getShapeView().size());
+    std::iota(vecCandidates.begin(), vecCandidates.end(), 0);
+    vecCandidates.erase(std::remove_if(vecCandidates.begin(), vecCandidates.end(), [&mesh](int i) { return mesh.isSuperPoint(i); }),
+                        vecCandidates.end());
+    std::shuffle(vecCandidates.begin(), vecCandidates.end(), gen);
+    vecCandidates.resize(REMOVED_POINTS);
+
+    int iFailures = 0;
+    const std::vector<Triangle> vecBefore(mesh.getTriView().begin(), mesh.getTriView().end());
+    std::vector<int> vecChanged;
+    int iRemoved = 0;
+    for (int iPointIndex : vecCandidates)
+    {
+        iRemoved += mesh.removePoint(iPointIndex, &vecChanged);
+    }
+    if (iRemoved != REMOVED_POINTS || mesh.removePoint(vecCandidates.front()))
+    {
+        std::cerr << pszConfig << ": " << iRemoved << " of " << REMOVED_POINTS << " removals succeeded, or a removed point was removed again" << std::endl;
+        ++iFailures;
+    }
+
+    std::sort(vecChanged.begin(), vecChanged.end());
+    vecChanged.erase(std::unique(vecChanged.begin(), vecChanged.end()), vecChanged.end());
+    const int iUnreported = countUnreported(mesh, vecBefore, vecChanged);
+    const int iDefects = countDefects(mesh);
+    const int iFreeSlots = countFreeSlots(mesh);
+    if (iUnreported != 0 || iDefects != 0 || iFreeSlots != 2 * REMOVED_POINTS || mesh.getTriView().size() != vecBefore.size())
+    {
+        std::cerr << pszConfig << ": after the removals " << iUnreported << " slots unreported, " << iDefects << " defects, "
+                  << iFreeSlots << " free slots, " << mesh.getTriView().size() << " slots for " << vecBefore.size() << " before" << std::endl;
+        ++iFailures;
+    }
+
+    // Each insertion adds two triangles, which go to free slots as long as there are any
+    std::vector<Point> vecBatch;
+    for (int i = 0; i < REINSERTED_POINTS; ++i)
+    {
+        vecBatch.emplace_back(dis(gen), dis(gen));
+    }
+    mesh.insertPoints(vecBatch);
+
+    const size_t uExpectedSlots = vecBefore.size() + std::max(0, 2 * REINSERTED_POINTS - iFreeSlots);
+    const int iDefectsAfterInsertion = countDefects(mesh);
+    const int iFreeAfterInsertion = countFreeSlots(mesh);
+    if (iDefectsAfterInsertion != 0 || iFreeAfterInsertion != 0 || mesh.getTriView().size() != uExpectedSlots)
+    {
+        std::cerr << pszConfig << ": after the insertions " << iDefectsAfterInsertion << " defects, " << iFreeAfterInsertion
+                  << " free slots, " << mesh.getTriView().size() << " slots for " << uExpectedSlots << " expected" << std::endl;
+        ++iFailures;
+    }
+
+    return iFailures;
+}
+
+// Checks Mesh::removePoint with both insertion engines, with and without the bucket grid
+int main()
+{
+    int iFailures = 0;
+    for (InsertionEngine eEngine : { InsertionEngine::SplitAndFlip, InsertionEngine::BowyerWatson })
+    {
+        for (bool bGrid : { false, true })
+        {
+            iFailures += testRemovePoint(eEngine, bGrid);
+        }
+    }
+
+    std::cout << (iFailures == 0 ? "removePoint checks passed" : "removePoint checks failed") << std::endl;
+    return iFailures == 0 ? 0 : 1;
+}
@@ -0,0 +1,77 @@
+#include "mesh.h"
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+// Builds a mesh from the points and returns the time taken in seconds
+static double timeBuild(const std::vector<Point>& vecPt, bool bParallel, int iThreads, int& iTriangleCount)
+{
+    Mesh mesh(vecPt);
+    if (bParallel)
+    {
+        mesh.setParallelBuild(true, iThreads);
+    }
+    else
+    {
+        mesh.setSpatialSort(true);
+        mesh.setInsertionEngine(InsertionEngine::BowyerWatson);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    mesh.setTriVector({ mesh.superTriangle() });
+    mesh.buildMesh();
+    double dSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    iTriangleCount = mesh.getTriView().size();
+    return dSeconds;
+}
+
+// Scaling curve of the parallel divide-and-conquer build from 1 to N threads.
+// Usage: scaling_bench [point count] [maximum thread count]
+int main(int argc, char* argv[])
+{
+    const int iPointCount = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    const int iMaxThreads = argc > 2 ? std::atoi(argv[2]) : std::max(1u, std::thread::hardware_concurrency());
+
+    std::mt19937 gen(12345);
+    std::uniform_real_distribution<float> dis(0.0f, 1000.0f);
+    std::vector<Point> vecPt;
+    vecPt.reserve(iPointCount);
+    for (int i = 0; i < iPointCount; ++i)
+    {
+        vecPt.emplace_back(dis(gen), dis(gen));
+    }
+
+    std::cout << "points " << iPointCount << ", hardware threads " << std::thread::hardware_concurrency() << std::endl;
+
+    int iTriangleCount = 0;
+    double dIncremental = timeBuild(vecPt, false, 1, iTriangleCount);
+    std::cout << "incremental (sorted Bowyer-Watson): " << dIncremental << " s, " << iTriangleCount << " triangles" << std::endl;
+
+    std::cout << "threads\tseconds\tspeedup\tefficiency" << std::endl;
+
+    // Powers of two up to the maximum, then the maximum itself
+    std::vector<int> vecThreadCounts;
+    for (int iThreads = 1; iThreads < iMaxThreads; iThreads *= 2)
+    {
+        vecThreadCounts.push_back(iThreads);
+    }
+    vecThreadCounts.push_back(iMaxThreads);
+
+    double dSingle = 0.0;
+    for (int iThreads : vecThreadCounts)
+    {
+        double dSeconds = timeBuild(vecPt, true, iThreads, iTriangleCount);
+        if (iThreads == 1)
+        {
+            dSingle = dSeconds;
+        }
+        std::cout << iThreads << "\t" << dSeconds << "\t" << dSingle / dSeconds << "\t" << dSingle / dSeconds / iThreads << std::endl;
+    }
+
+    return 0;
+}
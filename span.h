@@ -0,0 +1,37 @@
+#ifndef SPAN_H
+#define SPAN_H
+
+#include <cstddef>
+#include <vector>
+
+// Non-owning view of a contiguous array, a minimal stand-in for C++20 std::span.
+// The view is only valid while the viewed storage is neither destroyed nor reallocated.
+template<typename T>
+class Span {
+
+private:
+    T* pData{nullptr};  // First element
+    size_t uSize{0};  // Number of elements
+
+public:
+    Span() = default;
+    Span(T* pData, size_t uSize) : pData(pData), uSize(uSize) {}
+    Span(T* pBegin, T* pEnd) : pData(pBegin), uSize(pEnd - pBegin) {}
+
+    // Views of a vector (a Span<const T> binds to a const vector)
+    template<typename U>
+    Span(std::vector<U>& vec) : pData(vec.data()), uSize(vec.size()) {}
+    template<typename U>
+    Span(const std::vector<U>& vec) : pData(vec.data()), uSize(vec.size()) {}
+
+    T* data() const { return pData; }
+    size_t size() const { return uSize; }
+    bool empty() const { return uSize == 0; }
+
+    T* begin() const { return pData; }
+    T* end() const { return pData + uSize; }
+
+    T& operator[](size_t i) const { return pData[i]; }
+};
+
+#endif // SPAN_H
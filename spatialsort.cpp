@@ -0,0 +1,111 @@
+#include "spatialsort.h"
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+// Resolution of the Hilbert curve along each axis (2^16 cells per side)
+static const std::uint32_t HILBERT_ORDER = 1u << 16;
+
+// Smallest number of points inserted in the first BRIO round
+static const int BRIO_MIN_ROUND = 64;
+
+// Computes the distance of a point along a Hilbert curve laid over the given bounding box
+std::uint32_t hilbertIndex(const Point& pt, float fMinX, float fMinY, float fMaxX, float fMaxY)
+{
+    double dWidth = fMaxX - fMinX;
+    double dHeight = fMaxY - fMinY;
+
+    // Quantize the point onto the Hilbert grid, guarding against a degenerate bounding box
+    double dScaleX = dWidth > 0 ? (HILBERT_ORDER - 1) / dWidth : 0.0;
+    double dScaleY = dHeight > 0 ? (HILBERT_ORDER - 1) / dHeight : 0.0;
+
+    std::uint32_t uX = static_cast<std::uint32_t>((pt.getX() - fMinX) * dScaleX);
+    std::uint32_t uY = static_cast<std::uint32_t>((pt.getY() - fMinY) * dScaleY);
+
+    uX = std::min(uX, HILBERT_ORDER - 1);
+    uY = std::min(uY, HILBERT_ORDER - 1);
+
+    std::uint32_t uDistance = 0;
+
+    // Walk down the quadrant hierarchy, rotating the frame at each level
+    for (std::uint32_t uS = HILBERT_ORDER / 2; uS > 0; uS /= 2)
+    {
+        std::uint32_t uRx = (uX & uS) > 0 ? 1 : 0;
+        std::uint32_t uRy = (uY & uS) > 0 ? 1 : 0;
+
+        uDistance += uS * uS * ((3 * uRx) ^ uRy);
+
+        if (uRy == 0)
+        {
+            if (uRx == 1)
+            {
+                uX = HILBERT_ORDER - 1 - uX;
+                uY = HILBERT_ORDER - 1 - uY;
+            }
+            std::swap(uX, uY);
+        }
+    }
+
+    return uDistance;
+}
+
+// Sorts a range of point indices along the Hilbert curve using precomputed keys
+void hilbertSort(const std::vector<std::uint32_t>& vecKeys, std::vector<int>::iterator itBegin, std::vector<int>::iterator itEnd)
+{
+    std::sort(itBegin, itEnd, [&vecKeys](int iA, int iB) {
+        return vecKeys[iA] < vecKeys[iB];
+    });
+}
+
+// Computes a Biased Randomized Insertion Order for the first iCount points of spanPt.
+// Points are shuffled and split into rounds of doubling size; each round is then
+// sorted along a Hilbert curve so consecutive insertions stay spatially close.
+std::vector<int> brioOrder(Span<const Point> spanPt, int iCount, unsigned int uSeed)
+{
+    std::vector<int> vecOrder(std::max(iCount, 0));
+    std::iota(vecOrder.begin(), vecOrder.end(), 0);
+
+    if (iCount <= 1)
+    {
+        return vecOrder;
+    }
+
+    // Bounding box of the points being ordered
+    float fMinX = spanPt[0].getX(), fMaxX = spanPt[0].getX();
+    float fMinY = spanPt[0].getY(), fMaxY = spanPt[0].getY();
+
+    for (int i = 1; i < iCount; ++i)
+    {
+        fMinX = std::min(fMinX, spanPt[i].getX());
+        fMaxX = std::max(fMaxX, spanPt[i].getX());
+        fMinY = std::min(fMinY, spanPt[i].getY());
+        fMaxY = std::max(fMaxY, spanPt[i].getY());
+    }
+
+    // Precompute the Hilbert key of every point once
+    std::vector<std::uint32_t> vecKeys(iCount);
+    for (int i = 0; i < iCount; ++i)
+    {
+        vecKeys[i] = hilbertIndex(spanPt[i], fMinX, fMinY, fMaxX, fMaxY);
+    }
+
+    // Randomize the assignment of points to rounds
+    std::mt19937 gen(uSeed);
+    std::shuffle(vecOrder.begin(), vecOrder.end(), gen);
+
+    // The last round holds half of the points, the one before it a quarter, and so on
+    int iRoundEnd = iCount;
+    while (iRoundEnd > 0)
+    {
+        int iRoundBegin = iRoundEnd / 2;
+        if (iRoundBegin < BRIO_MIN_ROUND)
+        {
+            iRoundBegin = 0;
+        }
+
+        hilbertSort(vecKeys, vecOrder.begin() + iRoundBegin, vecOrder.begin() + iRoundEnd);
+        iRoundEnd = iRoundBegin;
+    }
+
+    return vecOrder;
+}
@@ -0,0 +1,19 @@
+#ifndef SPATIALSORT_H
+#define SPATIALSORT_H
+
+#include "point.h"
+#include "span.h"
+#include <cstdint>
+#include <vector>
+
+// Function to compute the distance of a point along a Hilbert curve laid over the given bounding box
+std::uint32_t hilbertIndex(const Point& pt, float fMinX, float fMinY, float fMaxX, float fMaxY);
+
+// Function to sort a range of point indices along the Hilbert curve
+void hilbertSort(const std::vector<std::uint32_t>& vecKeys, std::vector<int>::iterator itBegin, std::vector<int>::iterator itEnd);
+
+// Function to compute a Biased Randomized Insertion Order (BRIO) for the first iCount points of spanPt
+// (the points are only read, so a vector or a view of caller storage can be ordered without copying it)
+std::vector<int> brioOrder(Span<const Point> spanPt, int iCount, unsigned int uSeed);
+
+#endif // SPATIALSORT_H
@@ -0,0 +1,701 @@
+#include "streamingmesh.h"
+#include "predicates.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+// Finds the cell of a coordinate along one axis, clamped to the grid
+static int findCell(double dValue, float fMin, double dInvCellSize, int iCells)
+{
+    int iCell = static_cast<int>(std::floor((dValue - fMin) * dInvCellSize));
+    return std::min(std::max(iCell, 0), iCells - 1);
+}
+
+// Prepares the triangulation: a super triangle encloses the box, and every cell waits for its finalization tag
+StreamingMesh::StreamingMesh(float fMinX, float fMinY, float fMaxX, float fMaxY, int iCellsPerAxis, std::ostream& output)
+    : output(output), fMinX(fMinX), fMinY(fMinY), fMaxX(fMaxX), fMaxY(fMaxY), iCellsPerAxis(std::max(1, iCellsPerAxis))
+{
+    const double dWidth = static_cast<double>(fMaxX) - fMinX;
+    const double dHeight = static_cast<double>(fMaxY) - fMinY;
+    dInvCellWidth = dWidth > 0 ? this->iCellsPerAxis / dWidth : 0.0;
+    dInvCellHeight = dHeight > 0 ? this->iCellsPerAxis / dHeight : 0.0;
+
+    vecCellFinalized.assign(this->iCellsPerAxis * this->iCellsPerAxis, 0);
+    vecCellTriangles.resize(vecCellFinalized.size());
+
+    // Equilateral triangle around the circle enclosing the box, far enough away to keep the hull close to convex
+    double dCenterX = 0.5 * (static_cast<double>(fMinX) + fMaxX);
+    double dCenterY = 0.5 * (static_cast<double>(fMinY) + fMaxY);
+    double dRadius = 0.5 * std::sqrt(dWidth * dWidth + dHeight * dHeight);
+    if (dRadius == 0)
+    {
+        dRadius = 1.0;
+    }
+    dRadius *= SUPER_TRIANGLE_SCALE;
+
+    const double dSqrt3 = std::sqrt(3.0);
+    allocatePoint(dCenterX - dSqrt3 * dRadius, dCenterY - dRadius);
+    allocatePoint(dCenterX + dSqrt3 * dRadius, dCenterY - dRadius);
+    allocatePoint(dCenterX, dCenterY + 2.0 * dRadius);
+
+    setVertices(allocateTriangle(), 0, 1, 2);
+
+    output << std::setprecision(9);
+}
+
+// Finds the cell column of an x coordinate
+int StreamingMesh::findCellX(double dX) const
+{
+    return findCell(dX, fMinX, dInvCellWidth, iCellsPerAxis);
+}
+
+// Finds the cell row of a y coordinate
+int StreamingMesh::findCellY(double dY) const
+{
+    return findCell(dY, fMinY, dInvCellHeight, iCellsPerAxis);
+}
+
+// Allocates a point slot, reusing a released one if possible
+int StreamingMesh::allocatePoint(float fX, float fY)
+{
+    int iPoint;
+    if (!vecFreePoints.empty())
+    {
+        iPoint = vecFreePoints.back();
+        vecFreePoints.pop_back();
+    }
+    else
+    {
+        iPoint = vecX.size();
+        vecX.push_back(0.0f);
+        vecY.push_back(0.0f);
+        vecOutputIndex.push_back(-1);
+        vecPointTriangles.push_back(0);
+    }
+
+    vecX[iPoint] = fX;
+    vecY[iPoint] = fY;
+    vecOutputIndex[iPoint] = -1;
+    vecPointTriangles[iPoint] = 0;
+
+    iPeakActivePoints = std::max(iPeakActivePoints, ++iActivePoints);
+    return iPoint;
+}
+
+// Releases a point slot that no triangle uses any more
+void StreamingMesh::releasePoint(int iPoint)
+{
+    vecFreePoints.push_back(iPoint);
+    --iActivePoints;
+}
+
+// Allocates a triangle slot without points or neighbours, reusing a released one if possible
+int StreamingMesh::allocateTriangle()
+{
+    int iTriangle;
+    if (!vecFreeTriangles.empty())
+    {
+        iTriangle = vecFreeTriangles.back();
+        vecFreeTriangles.pop_back();
+    }
+    else
+    {
+        iTriangle = vecStamps.size();
+        vecVertices.insert(vecVertices.end(), 3, -1);
+        vecNeighbours.insert(vecNeighbours.end(), 3, -1);
+        vecStamps.push_back(0);
+    }
+
+    iPeakActiveTriangles = std::max(iPeakActiveTriangles, ++iActiveTriangles);
+    return iTriangle;
+}
+
+// Releases a triangle slot; the stamp change invalidates the cell registration of the triangle
+void StreamingMesh::releaseTriangle(int iTriangle)
+{
+    std::fill(vecVertices.begin() + 3 * iTriangle, vecVertices.begin() + 3 * iTriangle + 3, -1);
+    std::fill(vecNeighbours.begin() + 3 * iTriangle, vecNeighbours.begin() + 3 * iTriangle + 3, -1);
+    ++vecStamps[iTriangle];
+    vecFreeTriangles.push_back(iTriangle);
+    --iActiveTriangles;
+}
+
+// Sets the points of a triangle and counts the new uses of the points
+void StreamingMesh::setVertices(int iTriangle, int iPointA, int iPointB, int iPointC)
+{
+    vecVertices[3 * iTriangle] = iPointA;
+    vecVertices[3 * iTriangle + 1] = iPointB;
+    vecVertices[3 * iTriangle + 2] = iPointC;
+
+    ++vecPointTriangles[iPointA];
+    ++vecPointTriangles[iPointB];
+    ++vecPointTriangles[iPointC];
+}
+
+// Links an edge of a triangle with an encoded neighbour corner (or -1) in both directions
+void StreamingMesh::linkNeighbours(int iTriangle, int iEdge, int iCorner)
+{
+    vecNeighbours[3 * iTriangle + iEdge] = iCorner;
+
+    if (iCorner != -1)
+    {
+        vecNeighbours[iCorner] = 3 * iTriangle + iEdge;
+    }
+}
+
+// Checks whether a point slot holds one of the super triangle points
+bool StreamingMesh::isSuperPoint(int iPoint)
+{
+    return iPoint < 3;
+}
+
+// Walks from a triangle towards a point and returns the active triangle containing it
+// (-1 if the walk runs into the hole left by written triangles)
+int StreamingMesh::walk(int iStart, double dX, double dY) const
+{
+    int iCurrent = iStart;
+    int iEntryEdge = -1;  // Edge through which the walk entered the current triangle
+
+    for (int iSteps = 0; iSteps <= iActiveTriangles; ++iSteps)
+    {
+        const int* piVertices = &vecVertices[3 * iCurrent];
+
+        // Leave through the first edge that separates the triangle from the point, rotating the first edge tested
+        int iExitEdge = -1;
+        for (int i = 0; i < 3 && iExitEdge == -1; ++i)
+        {
+            int iEdge = (iSteps + i) % 3;
+            int iA = piVertices[iEdge], iB = piVertices[(iEdge + 1) % 3];
+            if (iEdge != iEntryEdge && orient2d(vecX[iA], vecY[iA], vecX[iB], vecY[iB], dX, dY) < 0)
+            {
+                iExitEdge = iEdge;
+            }
+        }
+
+        if (iExitEdge == -1)
+        {
+            return iCurrent;
+        }
+
+        int iNextCorner = vecNeighbours[3 * iCurrent + iExitEdge];
+        if (iNextCorner == -1)
+        {
+            return -1;
+        }
+
+        iCurrent = iNextCorner / 3;
+        iEntryEdge = iNextCorner % 3;
+    }
+
+    return -1;
+}
+
+// Finds an active triangle containing a point. The walk starts from the last insertion; when it runs into the
+// hole left by written triangles, it restarts from the last triangle waiting for the cell of the point, whose
+// circumcircle reaches into that cell, and only then are the active triangles scanned.
+int StreamingMesh::locate(double dX, double dY)
+{
+    int iTriangle = vecVertices[3 * iLastTriangle] != -1 ? walk(iLastTriangle, dX, dY) : -1;
+    if (iTriangle != -1)
+    {
+        return iTriangle;
+    }
+
+    const std::vector<std::pair<int, unsigned int>>& vecWaiting = vecCellTriangles[findCellY(dY) * iCellsPerAxis + findCellX(dX)];
+    for (auto it = vecWaiting.rbegin(); it != vecWaiting.rend(); ++it)
+    {
+        if (vecStamps[it->first] == it->second && vecVertices[3 * it->first] != -1)
+        {
+            iTriangle = walk(it->first, dX, dY);
+            break;
+        }
+    }
+    if (iTriangle != -1)
+    {
+        return iTriangle;
+    }
+
+    ++lLocateFallbacks;
+    for (iTriangle = 0; iTriangle < static_cast<int>(vecStamps.size()); ++iTriangle)
+    {
+        const int* piVertices = &vecVertices[3 * iTriangle];
+        if (piVertices[0] == -1)
+        {
+            continue;
+        }
+
+        bool bInside = true;
+        for (int i = 0; i < 3 && bInside; ++i)
+        {
+            int iA = piVertices[i], iB = piVertices[(i + 1) % 3];
+            bInside = orient2d(vecX[iA], vecY[iA], vecX[iB], vecY[iB], dX, dY) >= 0;
+        }
+
+        if (bInside)
+        {
+            return iTriangle;
+        }
+    }
+
+    return -1;
+}
+
+// Inserts a point with the Bowyer-Watson algorithm. Written triangles cannot be in conflict with the point, since their
+// circumcircles only cover finalized cells, so the cavity always lies in the active triangles.
+bool StreamingMesh::addPoint(float fX, float fY)
+{
+    if (!(fX >= fMinX && fX <= fMaxX && fY >= fMinY && fY <= fMaxY))
+    {
+        std::cerr << "Point (" << fX << ", " << fY << ") lies outside of the stream bounds." << std::endl;
+        return false;
+    }
+
+    if (vecCellFinalized[findCellY(fY) * iCellsPerAxis + findCellX(fX)])
+    {
+        std::cerr << "Point (" << fX << ", " << fY << ") lies in a finalized cell." << std::endl;
+        return false;
+    }
+
+    const int iContaining = locate(fX, fY);
+    if (iContaining == -1)
+    {
+        std::cerr << "No active triangle contains point (" << fX << ", " << fY << ")." << std::endl;
+        return false;
+    }
+
+    // Points that coincide with an existing point are skipped
+    for (int i = 0; i < 3; ++i)
+    {
+        int iPoint = vecVertices[3 * iContaining + i];
+        if (vecX[iPoint] == fX && vecY[iPoint] == fY)
+        {
+            return false;
+        }
+    }
+
+    auto inCavity = [this](int iTriangle) {
+        return std::find(vecCavity.begin(), vecCavity.end(), iTriangle) != vecCavity.end();
+    };
+
+    vecCavity.assign(1, iContaining);
+
+    bool bGrown = true;
+    while (bGrown)
+    {
+        bGrown = false;
+        vecBoundary.clear();
+
+        // Grow the cavity by adjacency and collect its boundary edges
+        for (size_t k = 0; k < vecCavity.size(); ++k)
+        {
+            const int iCurrent = vecCavity[k];
+
+            for (int i = 0; i < 3; ++i)
+            {
+                int iCorner = vecNeighbours[3 * iCurrent + i];
+                int iNeighbour = iCorner != -1 ? iCorner / 3 : -1;
+
+                if (iNeighbour != -1 && inCavity(iNeighbour))
+                {
+                    continue;  // Interior edge of the cavity
+                }
+
+                if (iNeighbour != -1)
+                {
+                    const int* piVertices = &vecVertices[3 * iNeighbour];
+                    if (incircle(vecX[piVertices[0]], vecY[piVertices[0]], vecX[piVertices[1]], vecY[piVertices[1]],
+                                 vecX[piVertices[2]], vecY[piVertices[2]], fX, fY) > 0)
+                    {
+                        vecCavity.push_back(iNeighbour);
+                        continue;
+                    }
+                }
+
+                vecBoundary.push_back({ vecVertices[3 * iCurrent + i], vecVertices[3 * iCurrent + (i + 1) % 3], iCorner });
+            }
+        }
+
+        // Every boundary edge must be visible from the point; absorb the triangle beyond an edge that is not and grow again
+        for (const CavityEdge& edge : vecBoundary)
+        {
+            if (orient2d(vecX[edge.iPointA], vecY[edge.iPointA], vecX[edge.iPointB], vecY[edge.iPointB], fX, fY) <= 0 &&
+                edge.iOuterCorner != -1 && !inCavity(edge.iOuterCorner / 3))
+            {
+                vecCavity.push_back(edge.iOuterCorner / 3);
+                bGrown = true;
+            }
+        }
+    }
+
+    bool bStar = vecBoundary.size() == vecCavity.size() + 2;
+    for (const CavityEdge& edge : vecBoundary)
+    {
+        bStar = bStar && orient2d(vecX[edge.iPointA], vecY[edge.iPointA], vecX[edge.iPointB], vecY[edge.iPointB], fX, fY) > 0;
+    }
+
+    if (!bStar)
+    {
+        std::cerr << "The cavity of point (" << fX << ", " << fY << ") is not a star, the point is skipped." << std::endl;
+        return false;
+    }
+
+    const int iPoint = allocatePoint(fX, fY);
+    vecOutputIndex[iPoint] = ++lPointCount;
+    output << "v " << fX << ' ' << fY << " 0\n";
+
+    // Reuse the cavity slots for the star, then allocate the two extra triangles
+    vecStarSlots.assign(vecCavity.begin(), vecCavity.end());
+    for (int iTriangle : vecCavity)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            --vecPointTriangles[vecVertices[3 * iTriangle + i]];
+        }
+        ++vecStamps[iTriangle];
+    }
+    while (vecStarSlots.size() < vecBoundary.size())
+    {
+        vecStarSlots.push_back(allocateTriangle());
+    }
+
+    // Retriangulate the cavity as a star (A, B, P); edge 0 faces the outside of the cavity
+    for (int j = 0; j < static_cast<int>(vecBoundary.size()); ++j)
+    {
+        const CavityEdge& edge = vecBoundary[j];
+        setVertices(vecStarSlots[j], edge.iPointA, edge.iPointB, iPoint);
+        linkNeighbours(vecStarSlots[j], 0, edge.iOuterCorner);
+    }
+
+    // Close the fan: the star triangle after (A, B, P) is the one starting at B, so its edge 2 faces edge 1
+    for (int j = 0; j < static_cast<int>(vecBoundary.size()); ++j)
+    {
+        for (int l = 0; l < static_cast<int>(vecBoundary.size()); ++l)
+        {
+            if (vecBoundary[l].iPointA == vecBoundary[j].iPointB)
+            {
+                linkNeighbours(vecStarSlots[j], 1, 3 * vecStarSlots[l] + 2);
+            }
+        }
+    }
+
+    iLastTriangle = vecStarSlots[0];
+
+    for (int iTriangle : vecStarSlots)
+    {
+        registerTriangle(iTriangle);
+    }
+
+    return true;
+}
+
+// Registers a triangle with the first unfinalized cell its circumcircle may touch, or writes it if there is none.
+// The circumcircle is enlarged by its rounding error so that the test errs on the side of keeping the triangle.
+void StreamingMesh::registerTriangle(int iTriangle)
+{
+    const int* piVertices = &vecVertices[3 * iTriangle];
+
+    // Triangles of the super triangle are dropped at the end
+    if (isSuperPoint(piVertices[0]) || isSuperPoint(piVertices[1]) || isSuperPoint(piVertices[2]))
+    {
+        return;
+    }
+
+    // Circumcircle relative to the first point
+    double dAx = vecX[piVertices[0]], dAy = vecY[piVertices[0]];
+    double dBx = vecX[piVertices[1]] - dAx, dBy = vecY[piVertices[1]] - dAy;
+    double dCx = vecX[piVertices[2]] - dAx, dCy = vecY[piVertices[2]] - dAy;
+
+    double dDet = dBx * dCy - dBy * dCx;
+    double dBLength = dBx * dBx + dBy * dBy;
+    double dCLength = dCx * dCx + dCy * dCy;
+
+    double dOffsetX = (dCy * dBLength - dBy * dCLength) / (2.0 * dDet);
+    double dOffsetY = (dBx * dCLength - dCx * dBLength) / (2.0 * dDet);
+    double dRadius = std::sqrt(dOffsetX * dOffsetX + dOffsetY * dOffsetY);
+
+    double dConditioning = (std::fabs(dBx * dCy) + std::fabs(dBy * dCx)) / std::fabs(dDet);
+    dRadius += (32.0 * dConditioning + 32.0) * std::ldexp(1.0, -53) * (std::fabs(dOffsetX) + std::fabs(dOffsetY) + dRadius);
+
+    double dCenterX = dAx + dOffsetX, dCenterY = dAy + dOffsetY;
+
+    int iCellX0 = 0, iCellX1 = iCellsPerAxis - 1, iCellY0 = 0, iCellY1 = iCellsPerAxis - 1;
+    if (std::isfinite(dRadius))
+    {
+        // A circle outside of the box can never receive a point
+        if (dCenterX + dRadius < fMinX || dCenterX - dRadius > fMaxX || dCenterY + dRadius < fMinY || dCenterY - dRadius > fMaxY)
+        {
+            writeTriangle(iTriangle);
+            return;
+        }
+
+        iCellX0 = findCellX(dCenterX - dRadius);
+        iCellX1 = findCellX(dCenterX + dRadius);
+        iCellY0 = findCellY(dCenterY - dRadius);
+        iCellY1 = findCellY(dCenterY + dRadius);
+    }
+
+    for (int iCellY = iCellY0; iCellY <= iCellY1; ++iCellY)
+    {
+        for (int iCellX = iCellX0; iCellX <= iCellX1; ++iCellX)
+        {
+            int iCell = iCellY * iCellsPerAxis + iCellX;
+            if (!vecCellFinalized[iCell])
+            {
+                std::vector<std::pair<int, unsigned int>>& vecWaiting = vecCellTriangles[iCell];
+                vecWaiting.emplace_back(iTriangle, vecStamps[iTriangle]);
+
+                // Drop the entries of destroyed triangles whenever the list reaches a power of two, so a cell that stays
+                // open for long does not accumulate them
+                if (vecWaiting.size() >= 64 && (vecWaiting.size() & (vecWaiting.size() - 1)) == 0)
+                {
+                    vecWaiting.erase(std::remove_if(vecWaiting.begin(), vecWaiting.end(), [this](const std::pair<int, unsigned int>& waiting) {
+                        return vecStamps[waiting.first] != waiting.second || vecVertices[3 * waiting.first] == -1;
+                    }), vecWaiting.end());
+                }
+                return;
+            }
+        }
+    }
+
+    writeTriangle(iTriangle);
+}
+
+// Writes a finished triangle, detaches it from its neighbours and releases the points it was the last user of
+void StreamingMesh::writeTriangle(int iTriangle)
+{
+    const int* piVertices = &vecVertices[3 * iTriangle];
+    output << "f " << vecOutputIndex[piVertices[0]] << ' ' << vecOutputIndex[piVertices[1]] << ' ' << vecOutputIndex[piVertices[2]] << '\n';
+    ++lTriangleCount;
+
+    for (int i = 0; i < 3; ++i)
+    {
+        int iCorner = vecNeighbours[3 * iTriangle + i];
+        if (iCorner != -1)
+        {
+            vecNeighbours[iCorner] = -1;
+        }
+
+        int iPoint = piVertices[i];
+        if (--vecPointTriangles[iPoint] == 0 && !isSuperPoint(iPoint))
+        {
+            releasePoint(iPoint);
+        }
+    }
+
+    releaseTriangle(iTriangle);
+}
+
+// Marks a cell as finalized and checks the triangles that were waiting for it
+void StreamingMesh::finalizeCell(int iCellX, int iCellY)
+{
+    if (iCellX < 0 || iCellX >= iCellsPerAxis || iCellY < 0 || iCellY >= iCellsPerAxis)
+    {
+        std::cerr << "Invalid cell (" << iCellX << ", " << iCellY << ") provided to finalizeCell." << std::endl;
+        return;
+    }
+
+    const int iCell = iCellY * iCellsPerAxis + iCellX;
+    if (vecCellFinalized[iCell])
+    {
+        return;
+    }
+    vecCellFinalized[iCell] = 1;
+
+    // Move the list out so that its memory is returned once the waiting triangles are checked
+    std::vector<std::pair<int, unsigned int>> vecWaiting;
+    vecWaiting.swap(vecCellTriangles[iCell]);
+
+    for (const std::pair<int, unsigned int>& waiting : vecWaiting)
+    {
+        // Skip triangles destroyed since they were registered
+        if (vecStamps[waiting.first] == waiting.second && vecVertices[3 * waiting.first] != -1)
+        {
+            registerTriangle(waiting.first);
+        }
+    }
+}
+
+// Finalizes every cell, which writes all triangles of input points, and drops the triangles of the super triangle
+void StreamingMesh::finish()
+{
+    for (int iCellY = 0; iCellY < iCellsPerAxis; ++iCellY)
+    {
+        for (int iCellX = 0; iCellX < iCellsPerAxis; ++iCellX)
+        {
+            finalizeCell(iCellX, iCellY);
+        }
+    }
+
+    vecX.clear(); vecY.clear(); vecOutputIndex.clear(); vecPointTriangles.clear(); vecFreePoints.clear();
+    vecVertices.clear(); vecNeighbours.clear(); vecStamps.clear(); vecFreeTriangles.clear();
+    iActivePoints = 0;
+    iActiveTriangles = 0;
+
+    output.flush();
+}
+
+// Returns the number of points inserted
+long long StreamingMesh::getPointCount() const
+{
+    return lPointCount;
+}
+
+// Returns the number of triangles written
+long long StreamingMesh::getTriangleCount() const
+{
+    return lTriangleCount;
+}
+
+// Returns the number of points held in memory, including the super triangle points
+int StreamingMesh::getActivePointCount() const
+{
+    return iActivePoints;
+}
+
+// Returns the number of triangles held in memory
+int StreamingMesh::getActiveTriangleCount() const
+{
+    return iActiveTriangles;
+}
+
+// Returns the largest number of points held in memory
+int StreamingMesh::getPeakActivePointCount() const
+{
+    return iPeakActivePoints;
+}
+
+// Returns the largest number of triangles held in memory
+int StreamingMesh::getPeakActiveTriangleCount() const
+{
+    return iPeakActiveTriangles;
+}
+
+// Returns the number of point locations that had to scan the active triangles
+long long StreamingMesh::getLocateFallbacks() const
+{
+    return lLocateFallbacks;
+}
+
+// Triangulates a finalized point stream read from input and writes the mesh to output
+bool StreamingMesh::triangulateStream(std::istream& input, std::ostream& output)
+{
+    std::string sTag;
+    float fMinX, fMinY, fMaxX, fMaxY;
+    int iCells;
+    if (!(input >> sTag) || sTag != "bounds" || !(input >> fMinX >> fMinY >> fMaxX >> fMaxY >> iCells))
+    {
+        std::cerr << "The point stream does not start with a bounds header." << std::endl;
+        return false;
+    }
+
+    StreamingMesh mesh(fMinX, fMinY, fMaxX, fMaxY, iCells, output);
+
+    while (input >> sTag)
+    {
+        if (sTag == "p")
+        {
+            float fX, fY;
+            if (!(input >> fX >> fY))
+            {
+                std::cerr << "Malformed point in the point stream." << std::endl;
+                return false;
+            }
+            mesh.addPoint(fX, fY);
+        }
+        else if (sTag == "f")
+        {
+            int iCellX, iCellY;
+            if (!(input >> iCellX >> iCellY))
+            {
+                std::cerr << "Malformed finalization tag in the point stream." << std::endl;
+                return false;
+            }
+            mesh.finalizeCell(iCellX, iCellY);
+        }
+        else
+        {
+            std::cerr << "Unknown tag '" << sTag << "' in the point stream." << std::endl;
+            return false;
+        }
+    }
+
+    mesh.finish();
+    return true;
+}
+
+// Writes a file of points as a finalized point stream. Only the per-cell point counts are held in memory;
+// cells without points are finalized right after the header.
+bool StreamingMesh::finalizePointFile(const std::string& sPointPath, std::ostream& output, int iCellsPerAxis)
+{
+    std::ifstream file(sPointPath);
+    if (!file)
+    {
+        std::cerr << "Could not open point file " << sPointPath << "." << std::endl;
+        return false;
+    }
+
+    iCellsPerAxis = std::max(1, iCellsPerAxis);
+
+    // First pass: bounding box
+    float fX, fY;
+    float fMinX = 0.0f, fMinY = 0.0f, fMaxX = 0.0f, fMaxY = 0.0f;
+    long long lCount = 0;
+    while (file >> fX >> fY)
+    {
+        fMinX = lCount == 0 ? fX : std::min(fMinX, fX);
+        fMinY = lCount == 0 ? fY : std::min(fMinY, fY);
+        fMaxX = lCount == 0 ? fX : std::max(fMaxX, fX);
+        fMaxY = lCount == 0 ? fY : std::max(fMaxY, fY);
+        ++lCount;
+    }
+
+    if (lCount == 0)
+    {
+        std::cerr << "Point file " << sPointPath << " contains no points." << std::endl;
+        return false;
+    }
+
+    const double dWidth = static_cast<double>(fMaxX) - fMinX;
+    const double dHeight = static_cast<double>(fMaxY) - fMinY;
+    const double dInvCellWidth = dWidth > 0 ? iCellsPerAxis / dWidth : 0.0;
+    const double dInvCellHeight = dHeight > 0 ? iCellsPerAxis / dHeight : 0.0;
+
+    // Second pass: points per cell
+    std::vector<long long> vecCellPoints(iCellsPerAxis * iCellsPerAxis, 0);
+    file.clear();
+    file.seekg(0);
+    while (file >> fX >> fY)
+    {
+        ++vecCellPoints[findCell(fY, fMinY, dInvCellHeight, iCellsPerAxis) * iCellsPerAxis + findCell(fX, fMinX, dInvCellWidth, iCellsPerAxis)];
+    }
+
+    output << std::setprecision(9);
+    output << "bounds " << fMinX << ' ' << fMinY << ' ' << fMaxX << ' ' << fMaxY << ' ' << iCellsPerAxis << '\n';
+
+    for (int iCell = 0; iCell < static_cast<int>(vecCellPoints.size()); ++iCell)
+    {
+        if (vecCellPoints[iCell] == 0)
+        {
+            output << "f " << iCell % iCellsPerAxis << ' ' << iCell / iCellsPerAxis << '\n';
+        }
+    }
+
+    // Third pass: the points, each cell finalized after its last point
+    file.clear();
+    file.seekg(0);
+    while (file >> fX >> fY)
+    {
+        int iCellX = findCell(fX, fMinX, dInvCellWidth, iCellsPerAxis);
+        int iCellY = findCell(fY, fMinY, dInvCellHeight, iCellsPerAxis);
+
+        output << "p " << fX << ' ' << fY << '\n';
+        if (--vecCellPoints[iCellY * iCellsPerAxis + iCellX] == 0)
+        {
+            output << "f " << iCellX << ' ' << iCellY << '\n';
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,126 @@
+#ifndef STREAMINGMESH_H
+#define STREAMINGMESH_H
+
+#include <iosfwd>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Class triangulating a stream of points with spatial finalization tags, keeping only the active front in memory.
+// The points lie in a bounding box divided into a grid of cells, and the stream announces with a finalization
+// tag when a cell has received its last point. A triangle whose circumcircle covers no unfinalized cell can no
+// longer be destroyed by a later point, so it is written out and dropped, together with the points that no
+// remaining triangle uses. Memory is bounded by the front between finalized and unfinalized space, not by the
+// number of points.
+// The output is a Wavefront OBJ stream: a "v x y 0" line per point when it is inserted and an "f a b c" line
+// (1-based, counter-clockwise) per finished triangle.
+class StreamingMesh {
+
+private:
+    std::ostream& output;  // Stream receiving the points and the finished triangles
+
+    float fMinX, fMinY, fMaxX, fMaxY;  // Bounding box of the points
+    int iCellsPerAxis;  // Number of finalization cells along each axis
+    double dInvCellWidth, dInvCellHeight;  // Inverse of the cell dimensions
+    std::vector<char> vecCellFinalized;  // Whether each cell has received all of its points
+    std::vector<std::vector<std::pair<int, unsigned int>>> vecCellTriangles;  // Triangles (slot, stamp) waiting for each cell to be finalized
+
+    static constexpr double SUPER_TRIANGLE_SCALE = 1.0e3;  // Size of the super triangle relative to the bounding box
+
+    // Points, addressed by slot; slots 0 to 2 hold the super triangle points
+    std::vector<float> vecX, vecY;  // Coordinates
+    std::vector<long long> vecOutputIndex;  // 1-based index of the point in the output (-1 for the super triangle points)
+    std::vector<int> vecPointTriangles;  // Number of active triangles using the point
+    std::vector<int> vecFreePoints;  // Point slots available for reuse
+
+    // Triangles, addressed by slot, counter-clockwise; neighbour i lies across the edge from point i to point (i + 1) % 3
+    std::vector<int> vecVertices;  // Point slots, three per triangle (-1 for a free slot)
+    std::vector<int> vecNeighbours;  // Encoded neighbour corners (triangle * 3 + edge), three per triangle (-1 if none or written)
+    std::vector<unsigned int> vecStamps;  // Stamp of each slot, bumped whenever the slot is freed
+    std::vector<int> vecFreeTriangles;  // Triangle slots available for reuse
+    int iLastTriangle{0};  // Triangle created by the last insertion, where the next point location starts
+
+    // Edge on the boundary of a Bowyer-Watson cavity, oriented counter-clockwise around the cavity
+    struct CavityEdge {
+        int iPointA, iPointB;  // Point slots of the edge
+        int iOuterCorner;  // Encoded corner of the triangle outside of the cavity (-1 if none)
+    };
+
+    std::vector<int> vecCavity;  // Scratch list of the triangles in conflict with the point being inserted
+    std::vector<CavityEdge> vecBoundary;  // Scratch list of the boundary edges of the cavity
+    std::vector<int> vecStarSlots;  // Scratch list of the slots of the star triangles
+
+    long long lPointCount{0};  // Number of points inserted
+    long long lTriangleCount{0};  // Number of triangles written
+    int iActivePoints{0}, iActiveTriangles{0};  // Number of points and triangles held in memory
+    int iPeakActivePoints{0}, iPeakActiveTriangles{0};  // Largest number of points and triangles held in memory
+    long long lLocateFallbacks{0};  // Number of point locations that had to scan the active triangles
+
+    // Function to find the cell containing a coordinate along one axis, clamped to the grid
+    int findCellX(double dX) const;
+    int findCellY(double dY) const;
+
+    // Functions to allocate and release point and triangle slots
+    int allocatePoint(float fX, float fY);
+    void releasePoint(int iPoint);
+    int allocateTriangle();
+    void releaseTriangle(int iTriangle);
+
+    // Function to set the points of a triangle, updating the point use counts
+    void setVertices(int iTriangle, int iPointA, int iPointB, int iPointC);
+
+    // Function to link a triangle edge with an encoded neighbour corner (or -1) in both directions
+    void linkNeighbours(int iTriangle, int iEdge, int iCorner);
+
+    // Function to check whether a point slot is one of the super triangle points
+    static bool isSuperPoint(int iPoint);
+
+    // Function to walk from a triangle to the active triangle containing a point (-1 if the walk is blocked)
+    int walk(int iStart, double dX, double dY) const;
+
+    // Function to find an active triangle containing a point (-1 if there is none)
+    int locate(double dX, double dY);
+
+    // Function to wait for the first unfinalized cell touched by the circumcircle of a triangle, or write it if there is none
+    void registerTriangle(int iTriangle);
+
+    // Function to write a finished triangle and drop it from memory
+    void writeTriangle(int iTriangle);
+
+public:
+    // Constructor to prepare the triangulation of points inside a box, with iCellsPerAxis x iCellsPerAxis finalization cells
+    StreamingMesh(float fMinX, float fMinY, float fMaxX, float fMaxY, int iCellsPerAxis, std::ostream& output);
+
+    // Function to insert a point, returning false if it lies outside of the box, in a finalized cell, or on an existing point
+    bool addPoint(float fX, float fY);
+
+    // Function to announce that a cell will receive no more points, writing the triangles it was holding back
+    void finalizeCell(int iCellX, int iCellY);
+
+    // Function to finalize every remaining cell and write the last triangles
+    void finish();
+
+    // Getters for the number of points inserted and triangles written
+    long long getPointCount() const;
+    long long getTriangleCount() const;
+
+    // Getters for the number of points and triangles currently held in memory, and for the largest numbers held
+    int getActivePointCount() const;
+    int getActiveTriangleCount() const;
+    int getPeakActivePointCount() const;
+    int getPeakActiveTriangleCount() const;
+
+    // Getter for the number of point locations that had to scan the active triangles
+    long long getLocateFallbacks() const;
+
+    // Function to triangulate a finalized point stream: a "bounds minX minY maxX maxY cells" header followed by
+    // "p x y" point lines and "f cellX cellY" finalization lines. Returns false if the stream is malformed.
+    static bool triangulateStream(std::istream& input, std::ostream& output);
+
+    // Function to turn a file of "x y" lines into a finalized point stream, in three passes over the file
+    // (bounding box, points per cell, then the points with a finalization tag after the last point of each cell)
+    static bool finalizePointFile(const std::string& sPointPath, std::ostream& output, int iCellsPerAxis);
+
+};
+
+#endif // STREAMINGMESH_H
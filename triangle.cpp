@@ -4,8 +4,13 @@
 #include <iostream>
 #include "triangle.h"
 #include "point.h"
+#include "predicates.h"
 #include <cmath>
 
+#if DELAUNAY_ENABLE_STATS
+thread_local long long Triangle::lCircumcircleHits = 0;
+thread_local long long Triangle::lCircumcircleMisses = 0;
+#endif
 
 // Default constructor: initializes the triangle with default points
 Triangle::Triangle()
@@ -14,9 +19,9 @@ Triangle::Triangle()
     this->pt1 = Point(3.0f, 0.0f);
     this->pt2 = Point(3.0f, 4.0f);
 
-    aiNeighbourIndices[0] = -1;
-    aiNeighbourIndices[1] = -1;
-    aiNeighbourIndices[2] = -1;
+    aiNeighbourCorners[0] = -1;
+    aiNeighbourCorners[1] = -1;
+    aiNeighbourCorners[2] = -1;
 
     aiPointIndices[0] = -1;
     aiPointIndices[1] = -1;
@@ -39,9 +44,9 @@ Triangle::Triangle(const Point& pt0, const Point& pt1, const Point& pt2)
         this->pt2 = pt2;
     }
 
-    aiNeighbourIndices[0] = -1;
-    aiNeighbourIndices[1] = -1;
-    aiNeighbourIndices[2] = -1;
+    aiNeighbourCorners[0] = -1;
+    aiNeighbourCorners[1] = -1;
+    aiNeighbourCorners[2] = -1;
 
     aiPointIndices[0] = -1;
     aiPointIndices[1] = -1;
@@ -92,43 +97,46 @@ double Triangle::getArea() const
     return 0.5 * (pt0.getX() * (pt1.getY() - pt2.getY()) + pt1.getX() * (pt2.getY() - pt0.getY()) + pt2.getX() * (pt0.getY() - pt1.getY()));
 }
 
+// Check whether the triangle is an unused mesh slot
+bool Triangle::isFree() const
+{
+    return aiPointIndices[0] < 0;
+}
+
 // Check if the triangle contains a given point
 bool Triangle::contains(const Point& ptTargetPoint) const
 {
-    double dTpx = ptTargetPoint.getX();
-    double dTpy = ptTargetPoint.getY();
-
-    // Determinants of segments
-    double dL1 = (dTpx - pt0.getX()) * (pt1.getY() - pt0.getY()) - (pt1.getX() - pt0.getX()) * (dTpy - pt0.getY());
-    double dL2 = (dTpx - pt1.getX()) * (pt2.getY() - pt1.getY()) - (pt2.getX() - pt1.getX()) * (dTpy - pt1.getY());
-    double dL3 = (dTpx - pt2.getX()) * (pt0.getY() - pt2.getY()) - (pt0.getX() - pt2.getX()) * (dTpy - pt2.getY());
-
-    // All the signs must be the same (all positive or all negative)
-    bool bHasPos = (dL1 > 0) || (dL2 > 0) || (dL3 > 0);
-
-    return !(bHasPos);  // Either all positive or all negative
+    // The point must not be strictly right of any edge of the counter-clockwise triangle
+    return orient2d(pt0, pt1, ptTargetPoint) >= 0 &&
+           orient2d(pt1, pt2, ptTargetPoint) >= 0 &&
+           orient2d(pt2, pt0, ptTargetPoint) >= 0;
 }
 
 // Find the path to the triangle containing a given point
 int Triangle::findPathToContainingTriangle(const Point& ptTargetPoint) const
 {
-    double dTpx = ptTargetPoint.getX();
-    double dTpy = ptTargetPoint.getY();
+    // Cross the first edge that has the point strictly on its outer side
+    if (orient2d(pt0, pt1, ptTargetPoint) < 0) return getNeighbourIndex(0);
+    if (orient2d(pt1, pt2, ptTargetPoint) < 0) return getNeighbourIndex(1);
+    if (orient2d(pt2, pt0, ptTargetPoint) < 0) return getNeighbourIndex(2);
 
-    // Determinants of segments
-    double dL1 = (dTpx - pt0.getX()) * (pt1.getY() - pt0.getY()) - (pt1.getX() - pt0.getX()) * (dTpy - pt0.getY());
-    double dL2 = (dTpx - pt1.getX()) * (pt2.getY() - pt1.getY()) - (pt2.getX() - pt1.getX()) * (dTpy - pt1.getY());
-    double dL3 = (dTpx - pt2.getX()) * (pt0.getY() - pt2.getY()) - (pt0.getX() - pt2.getX()) * (dTpy - pt2.getY());
+    return -1; // Return -1 if the triangle contains the point
+}
 
-    if (!contains(ptTargetPoint))
+// Find the edge a walk towards a given point should cross (-1 if the triangle contains the point)
+int Triangle::findExitEdge(const Point& ptTargetPoint, int iStartEdge, int iEntryEdge) const
+{
+    // Test the edges in rotated order, never going back through the entry edge
+    for (int i = 0; i < 3; ++i)
     {
-        if (dL1 > 0) return getNeighbourIndex(0);
-        if (dL2 > 0) return getNeighbourIndex(1);
-        if (dL3 > 0) return getNeighbourIndex(2);
-
+        int iEdge = (iStartEdge + i) % 3;
+        if (iEdge != iEntryEdge && orient2d(getPoint(iEdge), getPoint((iEdge + 1) % 3), ptTargetPoint) < 0)
+        {
+            return iEdge;
+        }
     }
 
-    return -1; // Return -1 if no positive determinant is found
+    return -1; // Return -1 if no edge separates the triangle from the point
 }
 
 // Set a specific point of the triangle
@@ -138,6 +146,7 @@ void Triangle::setPoint(int iPoint, const Point& newPoint)
     if (iPoint == 1) this->pt1 = newPoint;
     if (iPoint == 2) this->pt2 = newPoint;
 
+    bCircumcircleValid = false; // The cached circumcircle no longer matches the points
 }
 
 
@@ -161,111 +170,149 @@ void Triangle::printPoints() const
     std::cout << oss.str() << std::endl; // Output the string
 }
 
-// Get the circumcenter of the triangle
-Point Triangle::getCircumcenter() const {
-    double dX1 = pt0.getX(), dY1 = pt0.getY();
-    double dX2 = pt1.getX(), dY2 = pt1.getY();
-    double dX3 = pt2.getX(), dY3 = pt2.getY();
+// Recompute the cached circumcircle if the points changed since the last query
+void Triangle::updateCircumcircle() const
+{
+    if (bCircumcircleValid)
+    {
+#if DELAUNAY_ENABLE_STATS
+        ++lCircumcircleHits;
+#endif
+        return;
+    }
+#if DELAUNAY_ENABLE_STATS
+    ++lCircumcircleMisses;
+#endif
 
-    // Midpoints of the sides
-    Point ptMidAB((dX1 + dX2) / 2, (dY1 + dY2) / 2);
-    Point ptMidBC((dX2 + dX3) / 2, (dY2 + dY3) / 2);
+    // Work relative to pt0 so that rounding scales with the size of the triangle, not its position
+    double dAx = static_cast<double>(pt1.getX()) - pt0.getX();
+    double dAy = static_cast<double>(pt1.getY()) - pt0.getY();
+    double dBx = static_cast<double>(pt2.getX()) - pt0.getX();
+    double dBy = static_cast<double>(pt2.getY()) - pt0.getY();
 
-    // Find slopes of the sides
-    double dSlopeAB = pt0.findSlope(pt1);
-    double dSlopeBC = pt1.findSlope(pt2);
+    double dDet = dAx * dBy - dAy * dBx;
+    double dALength = dAx * dAx + dAy * dAy;
+    double dBLength = dBx * dBx + dBy * dBy;
 
-    // Determine perpendicular slopes
-    double dPerpSlopeAB, dPerpSlopeBC;
+    dCircumcenterOffsetX = (dBy * dALength - dAy * dBLength) / (2.0 * dDet);
+    dCircumcenterOffsetY = (dAx * dBLength - dBx * dALength) / (2.0 * dDet);
+    dSquaredCircumradius = dCircumcenterOffsetX * dCircumcenterOffsetX + dCircumcenterOffsetY * dCircumcenterOffsetY;
 
-    if (dSlopeAB == 0)
-    {
-        dPerpSlopeAB = INFINITY; // Perpendicular to horizontal line is vertical
-    }
-    else
-    {
-        dPerpSlopeAB = -1 / dSlopeAB;
-    }
+    // The center inherits the conditioning of the determinant; flat triangles have no usable cache
+    double dConditioning = (std::fabs(dAx * dBy) + std::fabs(dAy * dBx)) / std::fabs(dDet);
+    dCircumcircleErrorBound = std::isfinite(dConditioning) ? (32.0 * dConditioning + 32.0) * std::ldexp(1.0, -53) : INFINITY;
 
-    if (dSlopeBC == 0)
-    {
-        dPerpSlopeBC = INFINITY; // Perpendicular to horizontal line is vertical
-    }
-    else
-    {
-        dPerpSlopeBC = -1 / dSlopeBC;
-    }
+    bCircumcircleValid = true;
+}
 
-    double dIntercept1, dIntercept2;
-    bool bIsVerticalAB = (dPerpSlopeAB == INFINITY);
-    bool bIsVerticalBC = (dPerpSlopeBC == INFINITY);
+// Get the circumcenter of the triangle
+Point Triangle::getCircumcenter() const
+{
+    updateCircumcircle();
+    return Point(pt0.getX() + dCircumcenterOffsetX, pt0.getY() + dCircumcenterOffsetY);
+}
 
-    // Form the equations of the perpendicular bisectors
-    if (bIsVerticalAB)
-    {
-        dIntercept1 = ptMidAB.getX();
-    }
-    else
-    {
-        dIntercept1 = ptMidAB.getY() - dPerpSlopeAB * ptMidAB.getX();
-    }
+// Get the squared radius of the circumcircle
+double Triangle::getSquaredCircumradius() const
+{
+    updateCircumcircle();
+    return dSquaredCircumradius;
+}
 
-    if (bIsVerticalBC)
-    {
-        dIntercept2 = ptMidBC.getX();
-    }
-    else
-    {
-        dIntercept2 = ptMidBC.getY() - dPerpSlopeBC * ptMidBC.getX();
-    }
+// Check if a point is inside the circumcircle
+bool Triangle::isInCircumcircle(const Point& pt) const
+{
+    updateCircumcircle();
 
-    double dCircumcenterX, dCircumcenterY;
+    // Compare against the cached circle when the answer is clear despite rounding
+    double dDx = (static_cast<double>(pt.getX()) - pt0.getX()) - dCircumcenterOffsetX;
+    double dDy = (static_cast<double>(pt.getY()) - pt0.getY()) - dCircumcenterOffsetY;
+    double dSquaredDistance = dDx * dDx + dDy * dDy;
 
-    // Solve the equations to find the intersection point (circumcenter)
-    if (bIsVerticalAB)
-    {
-        dCircumcenterX = dIntercept1;
-        dCircumcenterY = dPerpSlopeBC * dCircumcenterX + dIntercept2;
-    }
-    else if (bIsVerticalBC)
+    double dDifference = dSquaredDistance - dSquaredCircumradius;
+    if (std::fabs(dDifference) > dCircumcircleErrorBound * (dSquaredDistance + dSquaredCircumradius))
     {
-        dCircumcenterX = dIntercept2;
-        dCircumcenterY = dPerpSlopeAB * dCircumcenterX + dIntercept1;
-    }
-    else
-    {
-        dCircumcenterX = (dIntercept2 - dIntercept1) / (dPerpSlopeAB - dPerpSlopeBC);
-        dCircumcenterY = dPerpSlopeAB * dCircumcenterX + dIntercept1;
+        return dDifference < 0;
     }
 
-    return Point(dCircumcenterX, dCircumcenterY);
+    // Too close to the circle: fall back to the exact predicate
+    // (the incircle determinant is positive for inside points of a counter-clockwise triangle)
+    double dOrientation = orient2d(pt0, pt1, pt2);
+    double dIncircle = incircle(pt0, pt1, pt2, pt);
+
+    return dOrientation < 0 ? dIncircle < 0 : dIncircle > 0;
 }
 
-// Check if a point is inside the circumcircle
-bool Triangle::isInCircumcircle(const Point& pt) const
+// Get the fraction of circumcircle queries on this thread answered from the cache
+double Triangle::getCircumcircleCacheHitRatio()
+{
+    long long lTotal = getCircumcircleCacheHits() + getCircumcircleCacheMisses();
+    return lTotal > 0 ? static_cast<double>(getCircumcircleCacheHits()) / lTotal : 0.0;
+}
+
+// Get the number of circumcircle queries on this thread answered from the cache
+long long Triangle::getCircumcircleCacheHits()
 {
-    Point ptCircumcenter = getCircumcenter();
-    double dRadius = ptCircumcenter.findDistance(getPoint(1)); // Calculate the radius
-    double dPointDistance = ptCircumcenter.findDistance(pt); // Calculate the distance from the point to the circumcenter
+#if DELAUNAY_ENABLE_STATS
+    return lCircumcircleHits;
+#else
+    return 0;
+#endif
+}
 
-    return dPointDistance < dRadius;
+// Get the number of circumcircle queries on this thread that recomputed the cache
+long long Triangle::getCircumcircleCacheMisses()
+{
+#if DELAUNAY_ENABLE_STATS
+    return lCircumcircleMisses;
+#else
+    return 0;
+#endif
+}
+
+// Reset the circumcircle cache statistics of this thread
+void Triangle::resetCircumcircleCacheStats()
+{
+#if DELAUNAY_ENABLE_STATS
+    lCircumcircleHits = 0;
+    lCircumcircleMisses = 0;
+#endif
 }
 
-// Getter for aiNeighbourIndices
+// Getter for the index of a neighbouring triangle
 int Triangle::getNeighbourIndex(int iIndex) const
+{
+    if (iIndex >= 0 && iIndex < 3 && aiNeighbourCorners[iIndex] >= 0)
+    {
+        return aiNeighbourCorners[iIndex] / 3;
+    }
+    return -1; // Return -1 for invalid index or missing neighbour
+}
+
+// Setter for the index of a neighbouring triangle (the facing edge is left at 0)
+void Triangle::setNeighbourIndex(int iIndex, int iValue) {
+    if (iIndex >= 0 && iIndex < 3)
+    {
+        aiNeighbourCorners[iIndex] = iValue >= 0 ? 3 * iValue : -1;
+    }
+}
+
+// Getter for aiNeighbourCorners
+int Triangle::getNeighbourCorner(int iIndex) const
 {
     if (iIndex >= 0 && iIndex < 3)
     {
-        return aiNeighbourIndices[iIndex];
+        return aiNeighbourCorners[iIndex];
     }
     return -1; // Return -1 for invalid index
 }
 
-// Setter for aiNeighbourIndices
-void Triangle::setNeighbourIndex(int iIndex, int iValue) {
+// Setter for aiNeighbourCorners
+void Triangle::setNeighbourCorner(int iIndex, int iCorner)
+{
     if (iIndex >= 0 && iIndex < 3)
     {
-        aiNeighbourIndices[iIndex] = iValue;
+        aiNeighbourCorners[iIndex] = iCorner;
     }
 }
 
@@ -305,8 +352,7 @@ int Triangle::onEdge(const Point& pt) const
 {
 
     // Check if pt is on the line segment 0
-    double crossProduct = (pt.getY() - pt0.getY()) * (pt1.getX() - pt0.getX()) - (pt.getX() - pt0.getX()) * (pt1.getY() - pt0.getY());
-    if (std::abs(crossProduct) < 1e-7) // Check for collinearity
+    if (orient2d(pt0, pt1, pt) == 0) // Check for collinearity
     {
         double dotProduct = (pt.getX() - pt0.getX()) * (pt1.getX() - pt0.getX()) + (pt.getY() - pt0.getY()) * (pt1.getY() - pt0.getY());
         if (dotProduct >= 0)
@@ -320,8 +366,7 @@ int Triangle::onEdge(const Point& pt) const
     }
 
     // Check if pt is on the line segment 1
-    crossProduct = (pt.getY() - pt1.getY()) * (pt2.getX() - pt1.getX()) - (pt.getX() - pt1.getX()) * (pt2.getY() - pt1.getY());
-    if (std::abs(crossProduct) < 1e-7) // Check for collinearity
+    if (orient2d(pt1, pt2, pt) == 0) // Check for collinearity
     {
         double dotProduct = (pt.getX() - pt1.getX()) * (pt2.getX() - pt1.getX()) + (pt.getY() - pt1.getY()) * (pt2.getY() - pt1.getY());
         if (dotProduct >= 0)
@@ -335,8 +380,7 @@ int Triangle::onEdge(const Point& pt) const
     }
 
     // Check if pt is on the line segment 2
-    crossProduct = (pt.getY() - pt2.getY()) * (pt0.getX() - pt2.getX()) - (pt.getX() - pt2.getX()) * (pt0.getY() - pt2.getY());
-    if (std::abs(crossProduct) < 1e-7) // Check for collinearity
+    if (orient2d(pt2, pt0, pt) == 0) // Check for collinearity
     {
         double dotProduct = (pt.getX() - pt2.getX()) * (pt0.getX() - pt2.getX()) + (pt.getY() - pt2.getY()) * (pt0.getY() - pt2.getY());
         if (dotProduct >= 0)
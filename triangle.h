@@ -2,6 +2,7 @@
 #define TRIANGLE_H
 
 #include "point.h"
+#include "meshstats.h"
 #include <vector>
 
 // Class representing a triangle defined by three points
@@ -9,9 +10,23 @@ class Triangle {
 private:
     Point pt0, pt1, pt2;  // Points defining the triangle
     int iIndex; // Index of the triangle
-    int aiNeighbourIndices[3];  // Indices of neighboring triangles
+    int aiNeighbourCorners[3];  // Neighbouring triangle and its edge facing back, encoded as triangle * 3 + edge (-1 if none)
     int aiPointIndices[3];  // Indices of points in the triangle
 
+    // Cached circumcircle, recomputed lazily after the points change
+    mutable double dCircumcenterOffsetX{0.0}, dCircumcenterOffsetY{0.0};  // Circumcenter relative to pt0
+    mutable double dSquaredCircumradius{0.0};  // Squared circumradius
+    mutable double dCircumcircleErrorBound{0.0};  // Relative error bound of distance comparisons against the cache
+    mutable bool bCircumcircleValid{false};  // Whether the cached values match the current points
+
+#if DELAUNAY_ENABLE_STATS
+    static thread_local long long lCircumcircleHits;  // Circumcircle queries answered from the cache
+    static thread_local long long lCircumcircleMisses;  // Circumcircle queries that had to recompute the cache
+#endif
+
+    // Function to make sure the cached circumcircle matches the current points
+    void updateCircumcircle() const;
+
 public:
     // Default constructor
     Triangle();
@@ -20,9 +35,14 @@ public:
     Triangle(const Point& pt0, const Point& pt1, const Point& pt2);
 
     // Getter and setter for neighboring triangle indices
+    // (the setter does not know the facing edge; Mesh::setTriVector resolves it from the point indices)
     int getNeighbourIndex(int iIndex) const;
     void setNeighbourIndex(int iIndex, int iValue);
 
+    // Getter and setter for the encoded neighbour corners (triangle * 3 + edge of the neighbour facing back)
+    int getNeighbourCorner(int iIndex) const;
+    void setNeighbourCorner(int iIndex, int iCorner);
+
     // Getter and setter for point indices
     int getPointIndex(int iIndex) const;
     int getPointIndex() const;
@@ -46,9 +66,15 @@ public:
     // Function to check if the triangle contains a given point
     bool contains(const Point& ptTargetPoint) const;
 
+    // Function to check whether the triangle is an unused slot of a mesh (a default triangle, without point indices)
+    bool isFree() const;
+
     // Function to find the path to the triangle containing a given point
     int findPathToContainingTriangle(const Point& ptTargetPoint) const;
 
+    // Function to find the edge a walk towards a given point should cross, testing edges from iStartEdge and skipping iEntryEdge
+    int findExitEdge(const Point& ptTargetPoint, int iStartEdge, int iEntryEdge) const;
+
     // Function to get a specified point of the triangle
     Point getPoint(int iPoint) const;
 
@@ -61,9 +87,18 @@ public:
     // Function to get the circumcenter of the triangle
     Point getCircumcenter() const;
 
+    // Function to get the squared radius of the circumcircle of the triangle
+    double getSquaredCircumradius() const;
+
     // Function to check if a point is inside the circumcircle of the triangle
     bool isInCircumcircle(const Point& pt) const;
 
+    // Functions to read and reset the circumcircle cache statistics of the calling thread (zero when DELAUNAY_ENABLE_STATS is 0)
+    static double getCircumcircleCacheHitRatio();
+    static long long getCircumcircleCacheHits();
+    static long long getCircumcircleCacheMisses();
+    static void resetCircumcircleCacheStats();
+
     // Function to determine whether a point is on the perimeter of the triangle, and on which edge is it located on
     int onEdge(const Point& pt) const;
 